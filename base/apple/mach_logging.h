@@ -61,9 +61,9 @@ class MachLogMessageFatal final : public MachLogMessage {
 
 #define MACH_LOG_STREAM(severity, mach_err) \
   COMPACT_GOOGLE_LOG_EX_##severity(MachLogMessage, mach_err).stream()
-#define MACH_VLOG_STREAM(verbose_level, mach_err)                        \
-  logging::MachLogMessage(                                               \
-      __PRETTY_FUNCTION__, __FILE__, __LINE__, -verbose_level, mach_err) \
+#define MACH_VLOG_STREAM(verbose_level, mach_err)                             \
+  logging::MachLogMessage(                                                    \
+      __PRETTY_FUNCTION__, LOG_FILE_NAME, __LINE__, -verbose_level, mach_err) \
       .stream()
 
 #define MACH_LOG(severity, mach_err) \
@@ -134,9 +134,12 @@ class BootstrapLogMessageFatal final : public BootstrapLogMessage {
 
 #define BOOTSTRAP_LOG_STREAM(severity, bootstrap_err) \
   COMPACT_GOOGLE_LOG_EX_##severity(BootstrapLogMessage, bootstrap_err).stream()
-#define BOOTSTRAP_VLOG_STREAM(verbose_level, bootstrap_err)                   \
-  logging::BootstrapLogMessage(                                               \
-      __PRETTY_FUNCTION__, __FILE__, __LINE__, -verbose_level, bootstrap_err) \
+#define BOOTSTRAP_VLOG_STREAM(verbose_level, bootstrap_err)   \
+  logging::BootstrapLogMessage(__PRETTY_FUNCTION__,           \
+                               LOG_FILE_NAME,                 \
+                               __LINE__,                      \
+                               -verbose_level,                \
+                               bootstrap_err)                 \
       .stream()
 
 #define BOOTSTRAP_LOG(severity, bootstrap_err)               \
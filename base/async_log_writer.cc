@@ -0,0 +1,363 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/async_log_writer.h"
+
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
+
+#include "base/posix/eintr_wrapper.h"
+
+namespace logging {
+namespace internal {
+
+namespace {
+
+constexpr size_t kSlotSize = 256;
+constexpr size_t kSlotDataSize =
+    kSlotSize - sizeof(std::atomic<uint64_t>) - sizeof(uint32_t);
+constexpr size_t kMinimumSlotCount = 16;
+
+// writev() accepts at most IOV_MAX buffers. Gathering more than this many
+// slots at once doesn’t reduce the number of system calls meaningfully, and
+// would make the iovec array uncomfortably large for the stack.
+constexpr int kMaxIovecs = IOV_MAX < 64 ? IOV_MAX : 64;
+
+// The writer created by the first AsyncLogWriter::Start(), whether or not it is
+// currently active.
+AsyncLogWriter* g_writer = nullptr;
+
+void DrainAtExit() {
+  if (AsyncLogWriter* writer = AsyncLogWriter::Get()) {
+    writer->Drain();
+  }
+}
+
+}  // namespace
+
+// Aligned so that each slot occupies whole cache lines of its own, which
+// operator new[] honors for over-aligned types.
+struct alignas(64) AsyncLogWriter::Slot {
+  // Equal to the slot’s position while it is free to be claimed for that
+  // position, and to the position + 1 once a message fragment has been
+  // published into it. Releasing the slot advances it by the capacity of the
+  // ring, making it free for the position one lap later.
+  std::atomic<uint64_t> sequence;
+  uint32_t length;
+  char data[kSlotDataSize];
+};
+
+// static
+std::atomic<AsyncLogWriter*> AsyncLogWriter::active_writer_;
+
+AsyncLogWriter::AsyncLogWriter(int fd,
+                               size_t buffer_size,
+                               AsyncLogOverflowPolicy policy)
+    : fd_(fd),
+      capacity_(std::bit_ceil(std::max(buffer_size / kSlotSize,
+                                       kMinimumSlotCount))),
+      mask_(capacity_ - 1),
+      policy_(policy),
+      slots_(new Slot[capacity_]),
+      enqueue_position_(0),
+      dequeue_position_(0),
+      dropped_count_(0),
+      drain_lock_(),
+      wait_lock_(),
+      work_(&wait_lock_),
+      space_(&wait_lock_),
+      writer_waiting_(false),
+      blocked_producers_(0),
+      thread_() {
+  static_assert(sizeof(Slot) == kSlotSize && alignof(Slot) == 64,
+                "slots should not straddle cache lines");
+  for (size_t index = 0; index < capacity_; ++index) {
+    slots_[index].sequence.store(index, std::memory_order_relaxed);
+  }
+}
+
+AsyncLogWriter::~AsyncLogWriter() = default;
+
+// static
+bool AsyncLogWriter::Start(int fd,
+                           size_t buffer_size,
+                           AsyncLogOverflowPolicy policy) {
+  if (!g_writer) {
+    AsyncLogWriter* writer = new AsyncLogWriter(fd, buffer_size, policy);
+    if (pthread_create(&writer->thread_, nullptr, &ThreadMain, writer) != 0) {
+      delete writer;
+      return false;
+    }
+
+    [[maybe_unused]] static bool registered = [] {
+      pthread_atfork(&AtForkPrepare, &AtForkParent, &AtForkChild);
+      atexit(&DrainAtExit);
+      return true;
+    }();
+
+    g_writer = writer;
+  }
+
+  g_writer->policy_.store(policy, std::memory_order_relaxed);
+  active_writer_.store(g_writer, std::memory_order_release);
+  return true;
+}
+
+// static
+void AsyncLogWriter::Stop() {
+  AsyncLogWriter* writer =
+      active_writer_.exchange(nullptr, std::memory_order_acq_rel);
+  if (writer) {
+    writer->Drain();
+  }
+}
+
+void AsyncLogWriter::Write(std::string_view message) {
+  if (message.empty()) {
+    return;
+  }
+
+  const size_t count = (message.size() + kSlotDataSize - 1) / kSlotDataSize;
+  if (count > capacity_) {
+    base::AutoLock lock(drain_lock_);
+    DrainLocked();
+    struct iovec iov = {const_cast<char*>(message.data()), message.size()};
+    WriteAll(&iov, 1);
+    return;
+  }
+
+  uint64_t position;
+  if (!TryClaim(count, &position)) {
+    if (policy_.load(std::memory_order_relaxed) ==
+        AsyncLogOverflowPolicy::kDrop) {
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      WakeWriter();
+      return;
+    }
+    ClaimBlocking(count, &position);
+  }
+
+  for (size_t index = 0; index < count; ++index) {
+    Slot& slot = slots_[(position + index) & mask_];
+    const size_t length = std::min(message.size(), kSlotDataSize);
+    memcpy(slot.data, message.data(), length);
+    slot.length = static_cast<uint32_t>(length);
+    message.remove_prefix(length);
+    slot.sequence.store(position + index + 1, std::memory_order_release);
+  }
+
+  WakeWriter();
+}
+
+void AsyncLogWriter::Drain() {
+  base::AutoLock lock(drain_lock_);
+  DrainLocked();
+}
+
+bool AsyncLogWriter::TryClaim(size_t count, uint64_t* position) {
+  uint64_t claim = enqueue_position_.load(std::memory_order_relaxed);
+  while (true) {
+    bool available = true;
+    for (size_t index = 0; index < count; ++index) {
+      const uint64_t sequence = slots_[(claim + index) & mask_].sequence.load(
+          std::memory_order_acquire);
+      if (sequence < claim + index) {
+        // The slot still holds a fragment from the previous lap that the
+        // writer thread hasn’t released yet.
+        return false;
+      }
+      if (sequence != claim + index) {
+        // Another thread claimed this slot after |claim| was loaded.
+        available = false;
+        break;
+      }
+    }
+
+    if (!available) {
+      claim = enqueue_position_.load(std::memory_order_relaxed);
+    } else if (enqueue_position_.compare_exchange_weak(
+                   claim, claim + count, std::memory_order_relaxed)) {
+      *position = claim;
+      return true;
+    }
+  }
+}
+
+void AsyncLogWriter::ClaimBlocking(size_t count, uint64_t* position) {
+  base::AutoLock lock(wait_lock_);
+  blocked_producers_.fetch_add(1, std::memory_order_relaxed);
+
+  // Pairs with the fence in DrainLocked(). Either this thread observes the
+  // slots released by the writer thread, or the writer thread observes
+  // |blocked_producers_| and broadcasts |space_| under |wait_lock_|.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  while (!TryClaim(count, position)) {
+    work_.Signal();
+    space_.Wait();
+  }
+
+  blocked_producers_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void AsyncLogWriter::WakeWriter() {
+  // Pairs with the fence in Run(). Either the writer thread observes the slot
+  // published by this thread before it waits, or this thread observes
+  // |writer_waiting_| and signals |work_| under |wait_lock_|.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (writer_waiting_.load(std::memory_order_relaxed)) {
+    base::AutoLock lock(wait_lock_);
+    work_.Signal();
+  }
+}
+
+bool AsyncLogWriter::HasWork() const {
+  const uint64_t position = dequeue_position_.load(std::memory_order_relaxed);
+  return slots_[position & mask_].sequence.load(std::memory_order_acquire) ==
+             position + 1 ||
+         dropped_count_.load(std::memory_order_relaxed) != 0;
+}
+
+bool AsyncLogWriter::DrainLocked() {
+  drain_lock_.AssertAcquired();
+
+  bool wrote = false;
+  uint64_t position = dequeue_position_.load(std::memory_order_relaxed);
+  while (true) {
+    struct iovec iov[kMaxIovecs];
+    int iov_count = 0;
+    while (iov_count < kMaxIovecs) {
+      Slot& slot = slots_[(position + iov_count) & mask_];
+      if (slot.sequence.load(std::memory_order_acquire) !=
+          position + iov_count + 1) {
+        break;
+      }
+      iov[iov_count].iov_base = slot.data;
+      iov[iov_count].iov_len = slot.length;
+      ++iov_count;
+    }
+
+    if (iov_count == 0) {
+      break;
+    }
+
+    WriteAll(iov, iov_count);
+
+    for (int index = 0; index < iov_count; ++index) {
+      slots_[(position + index) & mask_].sequence.store(
+          position + index + capacity_, std::memory_order_release);
+    }
+    position += iov_count;
+    dequeue_position_.store(position, std::memory_order_relaxed);
+    wrote = true;
+
+    // Pairs with the fence in ClaimBlocking().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (blocked_producers_.load(std::memory_order_relaxed) != 0) {
+      base::AutoLock lock(wait_lock_);
+      space_.Broadcast();
+    }
+  }
+
+  const uint64_t dropped =
+      dropped_count_.exchange(0, std::memory_order_relaxed);
+  if (dropped != 0) {
+    char note[64];
+    const int length = snprintf(note,
+                                sizeof(note),
+                                "[%" PRIu64 " log messages dropped]\n",
+                                dropped);
+    struct iovec iov = {note, static_cast<size_t>(length)};
+    WriteAll(&iov, 1);
+    wrote = true;
+  }
+
+  return wrote;
+}
+
+void AsyncLogWriter::WriteAll(struct iovec* iov, int iov_count) {
+  while (iov_count > 0) {
+    const ssize_t rv = HANDLE_EINTR(writev(fd_, iov, iov_count));
+    if (rv < 0) {
+      // There’s nowhere to report a failure to write a log message.
+      return;
+    }
+
+    size_t written = static_cast<size_t>(rv);
+    while (iov_count > 0 && written >= iov->iov_len) {
+      written -= iov->iov_len;
+      ++iov;
+      --iov_count;
+    }
+    if (iov_count > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+      iov->iov_len -= written;
+    }
+  }
+}
+
+// static
+void* AsyncLogWriter::ThreadMain(void* writer) {
+  static_cast<AsyncLogWriter*>(writer)->Run();
+  return nullptr;
+}
+
+void AsyncLogWriter::Run() {
+  while (true) {
+    {
+      base::AutoLock lock(drain_lock_);
+      if (DrainLocked()) {
+        continue;
+      }
+    }
+
+    base::AutoLock lock(wait_lock_);
+    writer_waiting_.store(true, std::memory_order_relaxed);
+
+    // Pairs with the fence in WakeWriter().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!HasWork()) {
+      work_.Wait();
+    }
+    writer_waiting_.store(false, std::memory_order_relaxed);
+  }
+}
+
+// static
+void AsyncLogWriter::AtForkPrepare() {
+  // Holding |drain_lock_| across fork() guarantees that the child doesn’t
+  // inherit it locked by a thread that doesn’t exist in the child.
+  if (g_writer) {
+    g_writer->drain_lock_.Acquire();
+  }
+}
+
+// static
+void AsyncLogWriter::AtForkParent() {
+  if (g_writer) {
+    g_writer->drain_lock_.Release();
+  }
+}
+
+// static
+void AsyncLogWriter::AtForkChild() {
+  // The writer thread doesn’t exist in the child, so the child reverts to
+  // synchronous writes. Anything still queued belongs to the parent, which
+  // will write it. The writer is abandoned so that a later Start() in the child
+  // creates a new one with its own thread. Its |drain_lock_| is abandoned with
+  // it, still held: the child’s thread has a new ID, which an error-checking
+  // mutex won’t accept as the owner.
+  if (g_writer) {
+    active_writer_.store(nullptr, std::memory_order_relaxed);
+    g_writer = nullptr;
+  }
+}
+
+}  // namespace internal
+}  // namespace logging
@@ -0,0 +1,137 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_ASYNC_LOG_WRITER_H_
+#define MINI_CHROMIUM_BASE_ASYNC_LOG_WRITER_H_
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <memory>
+#include <string_view>
+
+#include "base/logging.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+
+namespace logging {
+namespace internal {
+
+// AsyncLogWriter implements LogWriteMode::kAsynchronous. It moves the write()
+// of formatted log messages off of the logging thread.
+//
+// Logging threads copy each message into a bounded ring of fixed-size slots
+// without taking a lock. A dedicated thread drains published slots to a file
+// descriptor, gathering up to IOV_MAX slots into each writev() call. A message
+// longer than one slot occupies several consecutive slots that are claimed
+// together, so messages from different threads are never interleaved.
+//
+// When the ring is full, Write() blocks or discards the message according to
+// the AsyncLogOverflowPolicy. Drain() writes everything published so far on the
+// calling thread, and is used before a FATAL message crashes the process and at
+// exit.
+//
+// There is at most one AsyncLogWriter per process. It is created by the first
+// Start() call and is intentionally leaked, along with its thread.
+class AsyncLogWriter {
+ public:
+  AsyncLogWriter(const AsyncLogWriter&) = delete;
+  AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+  // Makes the process-wide writer active, creating it and its thread if
+  // necessary. |buffer_size| is only used when the writer is created. Returns
+  // false if the thread could not be started.
+  static bool Start(int fd, size_t buffer_size, AsyncLogOverflowPolicy policy);
+
+  // Drains and deactivates the process-wide writer, if any. Messages that are
+  // in the middle of being queued are still written by the writer thread.
+  static void Stop();
+
+  // Returns the active process-wide writer, or nullptr if asynchronous mode is
+  // not active.
+  static AsyncLogWriter* Get() {
+    return active_writer_.load(std::memory_order_acquire);
+  }
+
+  // Queues |message| for writing. A message too large to ever fit in the ring
+  // is written synchronously, after draining everything queued before it.
+  void Write(std::string_view message);
+
+  // Synchronously writes everything that has been queued so far.
+  void Drain();
+
+ private:
+  struct Slot;
+
+  AsyncLogWriter(int fd, size_t buffer_size, AsyncLogOverflowPolicy policy);
+  ~AsyncLogWriter();
+
+  // Attempts to claim |count| consecutive slots without blocking. On success,
+  // stores the position of the first slot in |position| and returns true.
+  // Returns false if the ring does not have room.
+  bool TryClaim(size_t count, uint64_t* position);
+
+  // Waits until |count| consecutive slots can be claimed, and claims them.
+  void ClaimBlocking(size_t count, uint64_t* position);
+
+  // Wakes the writer thread if it is waiting for work.
+  void WakeWriter();
+
+  // Returns true if the slot at |dequeue_position_| has been published or
+  // messages have been dropped since the last drain.
+  bool HasWork() const;
+
+  // Writes every published slot, in order, and releases them. Returns true if
+  // anything was written. |drain_lock_| must be held.
+  bool DrainLocked();
+
+  // Writes |iov_count| buffers from |iov| to |fd_|, retrying after partial
+  // writes and EINTR.
+  void WriteAll(struct iovec* iov, int iov_count);
+
+  static void* ThreadMain(void* writer);
+  void Run();
+
+  static void AtForkPrepare();
+  static void AtForkParent();
+  static void AtForkChild();
+
+  static std::atomic<AsyncLogWriter*> active_writer_;
+
+  const int fd_;
+  const size_t capacity_;
+  const uint64_t mask_;
+  std::atomic<AsyncLogOverflowPolicy> policy_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Claimed by logging threads. Slots between dequeue_position_ and
+  // enqueue_position_ are either being filled or waiting to be written.
+  alignas(64) std::atomic<uint64_t> enqueue_position_;
+
+  // Only advanced while |drain_lock_| is held.
+  alignas(64) std::atomic<uint64_t> dequeue_position_;
+  std::atomic<uint64_t> dropped_count_;
+
+  // Held while draining, by the writer thread or by Drain().
+  base::Lock drain_lock_;
+
+  // Protects sleeping and waking. The writer thread waits on |work_| when the
+  // ring is empty, and logging threads wait on |space_| when it is full and the
+  // policy is AsyncLogOverflowPolicy::kBlock.
+  base::Lock wait_lock_;
+  base::ConditionVariable work_;
+  base::ConditionVariable space_;
+  std::atomic<bool> writer_waiting_;
+  std::atomic<int> blocked_producers_;
+
+  pthread_t thread_;
+};
+
+}  // namespace internal
+}  // namespace logging
+
+#endif  // MINI_CHROMIUM_BASE_ASYNC_LOG_WRITER_H_
@@ -0,0 +1,315 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/binary_log.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <string_view>
+
+#include "base/files/scoped_file.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/synchronization/lock.h"
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_LINUX)
+#include <sys/syscall.h>
+#endif
+
+namespace logging {
+
+namespace internal {
+std::atomic<bool> g_binary_logging(false);
+}  // namespace internal
+
+namespace {
+
+// The size of each thread’s record buffer. A record that would not fit even in
+// an empty buffer is dropped.
+constexpr size_t kThreadBufferSize = 16 * 1024;
+
+// The frame header of kBinaryLogRecordsFrame: tag, pid, tid, and length.
+constexpr size_t kRecordsFrameHeaderSize = 1 + 4 + 8 + 4;
+
+// Guards g_binary_log_fd, g_next_site_id and g_fork_parent_pid, and serializes
+// writes so that frames are never interleaved.
+base::Lock*& BinaryLogLockPointer() {
+  static base::Lock* lock = new base::Lock();
+  return lock;
+}
+
+base::Lock& GetBinaryLogLock() {
+  return *BinaryLogLockPointer();
+}
+
+int g_binary_log_fd = -1;
+uint32_t g_next_site_id = 1;
+uint32_t g_fork_parent_pid = 0;
+
+class Writer {
+ public:
+  explicit Writer(char* out) : out_(out) {}
+
+  template <typename T>
+  void Put(T value) {
+    memcpy(out_, &value, sizeof(value));
+    out_ += sizeof(value);
+  }
+
+  void Put(std::string_view bytes) {
+    Put(static_cast<uint32_t>(bytes.size()));
+    memcpy(out_, bytes.data(), bytes.size());
+    out_ += bytes.size();
+  }
+
+  char* out() const { return out_; }
+
+ private:
+  char* out_;
+};
+
+void WriteLocked(const char* data, size_t size) {
+  GetBinaryLogLock().AssertAcquired();
+  while (size > 0) {
+    const ssize_t written = HANDLE_EINTR(write(g_binary_log_fd, data, size));
+    if (written <= 0) {
+      return;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+}
+
+uint64_t CurrentThreadId() {
+#if BUILDFLAG(IS_APPLE)
+  uint64_t thread;
+  pthread_threadid_np(pthread_self(), &thread);
+  return thread;
+#elif BUILDFLAG(IS_ANDROID)
+  return static_cast<uint64_t>(gettid());
+#elif BUILDFLAG(IS_LINUX)
+  return static_cast<uint64_t>(syscall(__NR_gettid));
+#else
+  return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pthread_self()));
+#endif
+}
+
+// A thread’s buffered records, which begin with room for the frame header.
+class ThreadBuffer {
+ public:
+  ThreadBuffer() : used_(kRecordsFrameHeaderSize) {}
+
+  ThreadBuffer(const ThreadBuffer&) = delete;
+  ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+  ~ThreadBuffer() { Flush(); }
+
+  // Returns space for a record of |size| bytes, writing out the buffer first if
+  // necessary, or nullptr if the record will never fit.
+  char* Reserve(size_t size) {
+    if (size > kThreadBufferSize - used_) {
+      if (size > kThreadBufferSize - kRecordsFrameHeaderSize) {
+        return nullptr;
+      }
+      Flush();
+    }
+    char* const record = &data_[used_];
+    used_ += size;
+    return record;
+  }
+
+  void Flush() {
+    if (used_ == kRecordsFrameHeaderSize) {
+      return;
+    }
+
+    Writer header(data_);
+    header.Put(internal::kBinaryLogRecordsFrame);
+    header.Put(static_cast<uint32_t>(getpid()));
+    header.Put(CurrentThreadId());
+    header.Put(static_cast<uint32_t>(used_ - kRecordsFrameHeaderSize));
+    {
+      base::AutoLock lock(GetBinaryLogLock());
+      WriteLocked(data_, used_);
+    }
+    used_ = kRecordsFrameHeaderSize;
+  }
+
+  // Discards the buffered records. A child process discards what it inherited
+  // from its parent, which the parent will write itself.
+  void Clear() { used_ = kRecordsFrameHeaderSize; }
+
+ private:
+  size_t used_;
+  char data_[kThreadBufferSize];
+};
+
+// Allocated on a thread’s first BLOG(), so that threads that never use the
+// binary log don’t pay for a buffer.
+thread_local std::unique_ptr<ThreadBuffer> g_thread_buffer;
+
+// Holding the lock across fork() keeps the child from inheriting it locked by a
+// thread that doesn’t exist in the child, and keeps the parent from defining
+// a site between the fork and the child’s kBinaryLogForkFrame.
+//
+// The child can’t release the lock that it inherits, because its thread has a
+// new ID, which an error-checking mutex won’t accept as the owner. It abandons
+// that lock for a new one instead.
+void AtForkPrepare() {
+  GetBinaryLogLock().Acquire();
+  g_fork_parent_pid = static_cast<uint32_t>(getpid());
+}
+
+void AtForkParent() {
+  GetBinaryLogLock().Release();
+}
+
+void AtForkChild() {
+  BinaryLogLockPointer() = new base::Lock();
+  base::AutoLock lock(GetBinaryLogLock());
+
+  char frame[1 + 4 + 4];
+  Writer writer(frame);
+  writer.Put(internal::kBinaryLogForkFrame);
+  writer.Put(static_cast<uint32_t>(getpid()));
+  writer.Put(g_fork_parent_pid);
+  WriteLocked(frame, sizeof(frame));
+
+  if (g_thread_buffer) {
+    g_thread_buffer->Clear();
+  }
+}
+
+size_t EncodedSize(const internal::BinaryLogArg& arg) {
+  if (arg.type == internal::BinaryLogArgType::kString) {
+    return sizeof(uint32_t) +
+           (arg.s ? strnlen(arg.s, internal::kMaxBinaryLogStringLength)
+                  : strlen("(null)"));
+  }
+  return sizeof(uint64_t);
+}
+
+}  // namespace
+
+bool StartBinaryLogging(const char* path) {
+  base::AutoLock lock(GetBinaryLogLock());
+  if (g_binary_log_fd != -1) {
+    return false;
+  }
+
+  base::ScopedFD fd(HANDLE_EINTR(
+      open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644)));
+  if (!fd.is_valid()) {
+    return false;
+  }
+  g_binary_log_fd = fd.release();
+
+  char header[sizeof(internal::kBinaryLogMagic) + sizeof(uint32_t)];
+  memcpy(header, internal::kBinaryLogMagic, sizeof(internal::kBinaryLogMagic));
+  memcpy(&header[sizeof(internal::kBinaryLogMagic)],
+         &internal::kBinaryLogByteOrderMark,
+         sizeof(internal::kBinaryLogByteOrderMark));
+  WriteLocked(header, sizeof(header));
+
+  pthread_atfork(&AtForkPrepare, &AtForkParent, &AtForkChild);
+  internal::g_binary_logging.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void FlushBinaryLog() {
+  if (g_thread_buffer) {
+    g_thread_buffer->Flush();
+  }
+}
+
+namespace internal {
+
+uint32_t BinaryLogSite::Register(std::initializer_list<BinaryLogArg> args) {
+  base::AutoLock lock(GetBinaryLogLock());
+
+  // Another thread may have registered the site while this one waited.
+  uint32_t id = id_.load(std::memory_order_relaxed);
+  if (id != 0) {
+    return id;
+  }
+  id = g_next_site_id++;
+
+  const std::string_view file(file_);
+  const std::string_view format(format_);
+  auto frame = std::make_unique<char[]>(1 + 4 * 4 + 4 + file.size() + 4 +
+                                        format.size() + 4 + args.size());
+  Writer writer(frame.get());
+  writer.Put(kBinaryLogSiteFrame);
+  writer.Put(static_cast<uint32_t>(getpid()));
+  writer.Put(id);
+  writer.Put(static_cast<int32_t>(severity_));
+  writer.Put(static_cast<uint32_t>(line_));
+  writer.Put(file);
+  writer.Put(format);
+  writer.Put(static_cast<uint32_t>(args.size()));
+  for (const BinaryLogArg& arg : args) {
+    writer.Put(arg.type);
+  }
+  WriteLocked(frame.get(), static_cast<size_t>(writer.out() - frame.get()));
+
+  // Records that use the ID can only be written after the definition.
+  id_.store(id, std::memory_order_release);
+  return id;
+}
+
+void WriteBinaryLogRecord(BinaryLogSite& site,
+                          std::initializer_list<BinaryLogArg> args) {
+  const uint32_t id = site.Id(args);
+
+  size_t size = sizeof(uint32_t) + sizeof(uint64_t);
+  for (const BinaryLogArg& arg : args) {
+    size += EncodedSize(arg);
+  }
+
+  if (!g_thread_buffer) {
+    g_thread_buffer = std::make_unique<ThreadBuffer>();
+  }
+  char* const record = g_thread_buffer->Reserve(size);
+  if (!record) {
+    return;
+  }
+
+  timeval tv;
+  gettimeofday(&tv, nullptr);
+
+  Writer writer(record);
+  writer.Put(id);
+  writer.Put(static_cast<uint64_t>(tv.tv_sec) * 1000000 +
+             static_cast<uint64_t>(tv.tv_usec));
+  for (const BinaryLogArg& arg : args) {
+    switch (arg.type) {
+      case BinaryLogArgType::kSigned:
+        writer.Put(arg.i);
+        break;
+      case BinaryLogArgType::kUnsigned:
+        writer.Put(arg.u);
+        break;
+      case BinaryLogArgType::kDouble:
+        writer.Put(arg.d);
+        break;
+      case BinaryLogArgType::kString:
+        writer.Put(arg.s ? std::string_view(
+                               arg.s, strnlen(arg.s, kMaxBinaryLogStringLength))
+                         : std::string_view("(null)"));
+        break;
+      case BinaryLogArgType::kPointer:
+        writer.Put(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(arg.p)));
+        break;
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace logging
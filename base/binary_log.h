@@ -0,0 +1,196 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_BINARY_LOG_H_
+#define MINI_CHROMIUM_BASE_BINARY_LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <initializer_list>
+#include <type_traits>
+
+#include "base/compiler_specific.h"
+#include "base/logging.h"
+
+// BLOG() records a message in the binary log without formatting it. Only the
+// callsite’s ID, a timestamp, and the raw bytes of the arguments are written,
+// and a printf-style format string is applied to them later, when the log is
+// decoded with the binary_log_decoder tool:
+//
+//   BLOG(INFO, "read %zu bytes from fd %d in %.3f ms", size, fd, ms);
+//
+// Arguments must be integers, enums, floating-point values, C strings, or
+// pointers, and are checked against the format string at compile time. Strings
+// are copied, truncated to kMaxBinaryLogStringLength bytes. Wide strings are
+// not supported, and passing one is a compile error.
+//
+// BLOG() does nothing until StartBinaryLogging() has been called, or when
+// |severity| is below the minimum log level.
+#define BLOG(severity, format, ...)                                         \
+  do {                                                                      \
+    if (LOG_IS_ON(severity) && ::logging::internal::IsBinaryLogging()) {    \
+      if (false) {                                                          \
+        ::logging::internal::CheckBinaryLogFormat(format, ##__VA_ARGS__);   \
+      }                                                                     \
+      static ::logging::internal::BinaryLogSite binary_log_site(            \
+          LOG_FILE_NAME, __LINE__, ::logging::LOG_##severity, format);      \
+      ::logging::internal::WriteBinaryLogRecord(binary_log_site,            \
+                                                {__VA_ARGS__});             \
+    }                                                                       \
+  } while (false)
+
+namespace logging {
+
+// Starts writing BLOG() records to a new file at |path|, replacing any existing
+// file. Binary logging can only be started once per process. Returns false if
+// it was already started or the file could not be created.
+bool StartBinaryLogging(const char* path);
+
+// Writes out the records buffered by the calling thread. Each thread buffers
+// its records, and writes them out when its buffer fills up, when it exits,
+// and when it logs a FATAL message.
+void FlushBinaryLog();
+
+namespace internal {
+
+// The binary log file format. All integers are in the byte order of the
+// machine that wrote the file, as indicated by kBinaryLogByteOrderMark.
+//
+// The file begins with kBinaryLogMagic and kBinaryLogByteOrderMark (uint32_t),
+// followed by a sequence of frames, each starting with a one-byte tag.
+//
+// Site IDs are only unique within a process, since a child process continues
+// numbering its callsites from where its parent was at fork(), just as the
+// parent does. Sites are therefore identified by pid and site_id.
+//
+// kBinaryLogSiteFrame defines a callsite before any record refers to it:
+//   uint32_t pid, uint32_t site_id, int32_t severity, uint32_t line,
+//   uint32_t file_length, file, uint32_t format_length, format,
+//   uint32_t arg_count, arg_count BinaryLogArgType bytes.
+//
+// kBinaryLogForkFrame is written by a child process before anything else, and
+// gives it the sites that its parent had defined up to that point:
+//   uint32_t pid, uint32_t parent_pid.
+//
+// kBinaryLogRecordsFrame holds records written by one thread:
+//   uint32_t pid, uint64_t tid, uint32_t length, then |length| bytes of
+//   records. Each record is:
+//     uint32_t site_id, uint64_t time (microseconds since the Unix epoch),
+//     and one value for each argument of the site, in order: 8 bytes for
+//     kSigned (int64_t), kUnsigned (uint64_t), kDouble (double) and kPointer
+//     (uint64_t), or, for kString, uint32_t length and |length| bytes.
+inline constexpr char kBinaryLogMagic[8] = {'m', 'c', 'b', 'l', 'o', 'g', '1',
+                                            '\n'};
+inline constexpr uint32_t kBinaryLogByteOrderMark = 0x01020304;
+inline constexpr uint8_t kBinaryLogSiteFrame = 'S';
+inline constexpr uint8_t kBinaryLogRecordsFrame = 'R';
+inline constexpr uint8_t kBinaryLogForkFrame = 'F';
+
+inline constexpr size_t kMaxBinaryLogStringLength = 1024;
+
+enum class BinaryLogArgType : uint8_t {
+  kSigned = 'i',
+  kUnsigned = 'u',
+  kDouble = 'f',
+  kString = 's',
+  kPointer = 'p',
+};
+
+// One argument to BLOG(), captured without formatting it.
+struct BinaryLogArg {
+  template <typename T>
+    requires(std::is_integral_v<T> && std::is_signed_v<T>)
+  constexpr BinaryLogArg(T value)
+      : type(BinaryLogArgType::kSigned), i(value) {}
+
+  template <typename T>
+    requires(std::is_integral_v<T> && !std::is_signed_v<T>)
+  constexpr BinaryLogArg(T value)
+      : type(BinaryLogArgType::kUnsigned), u(value) {}
+
+  template <typename T>
+    requires(std::is_enum_v<T>)
+  constexpr BinaryLogArg(T value)
+      : BinaryLogArg(static_cast<std::underlying_type_t<T>>(value)) {}
+
+  template <typename T>
+    requires(std::is_floating_point_v<T>)
+  constexpr BinaryLogArg(T value)
+      : type(BinaryLogArgType::kDouble), d(static_cast<double>(value)) {}
+
+  constexpr BinaryLogArg(const char* value)
+      : type(BinaryLogArgType::kString), s(value) {}
+
+  // A wchar_t* would be recorded as a pointer and its text lost, so it matches
+  // no constructor.
+  template <typename T>
+    requires(!std::is_same_v<std::remove_cv_t<T>, char> &&
+             !std::is_same_v<std::remove_cv_t<T>, wchar_t>)
+  constexpr BinaryLogArg(T* value)
+      : type(BinaryLogArgType::kPointer), p(value) {}
+
+  BinaryLogArgType type;
+  union {
+    int64_t i;
+    uint64_t u;
+    double d;
+    const char* s;
+    const void* p;
+  };
+};
+
+// The static description of one BLOG() callsite.
+class BinaryLogSite {
+ public:
+  constexpr BinaryLogSite(const char* file,
+                          int line,
+                          LogSeverity severity,
+                          const char* format)
+      : file_(file),
+        line_(line),
+        severity_(severity),
+        format_(format),
+        id_(0) {}
+
+  BinaryLogSite(const BinaryLogSite&) = delete;
+  BinaryLogSite& operator=(const BinaryLogSite&) = delete;
+
+  // Returns the site’s ID, writing its definition to the log the first time.
+  // The argument types are taken from |args|, which are the same at every call.
+  uint32_t Id(std::initializer_list<BinaryLogArg> args) {
+    const uint32_t id = id_.load(std::memory_order_acquire);
+    if (id != 0) [[likely]] {
+      return id;
+    }
+    return Register(args);
+  }
+
+ private:
+  uint32_t Register(std::initializer_list<BinaryLogArg> args);
+
+  const char* const file_;
+  const int line_;
+  const LogSeverity severity_;
+  const char* const format_;
+  std::atomic<uint32_t> id_;
+};
+
+extern std::atomic<bool> g_binary_logging;
+
+inline bool IsBinaryLogging() {
+  return g_binary_logging.load(std::memory_order_relaxed);
+}
+
+// Never called. Lets the compiler check BLOG() arguments against the format.
+PRINTF_FORMAT(1, 2) inline void CheckBinaryLogFormat(const char* format, ...) {}
+
+void WriteBinaryLogRecord(BinaryLogSite& site,
+                          std::initializer_list<BinaryLogArg> args);
+
+}  // namespace internal
+}  // namespace logging
+
+#endif  // MINI_CHROMIUM_BASE_BINARY_LOG_H_
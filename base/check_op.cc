@@ -0,0 +1,64 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/check_op.h"
+
+namespace logging {
+
+namespace {
+
+template <typename T>
+std::string StreamValue(const T& v) {
+  std::ostringstream ss;
+  ss << v;
+  return ss.str();
+}
+
+}  // namespace
+
+std::string CheckOpValueStr(int v) {
+  return StreamValue(v);
+}
+
+std::string CheckOpValueStr(unsigned v) {
+  return StreamValue(v);
+}
+
+std::string CheckOpValueStr(long v) {
+  return StreamValue(v);
+}
+
+std::string CheckOpValueStr(unsigned long v) {
+  return StreamValue(v);
+}
+
+std::string CheckOpValueStr(long long v) {
+  return StreamValue(v);
+}
+
+std::string CheckOpValueStr(unsigned long long v) {
+  return StreamValue(v);
+}
+
+std::string CheckOpValueStr(double v) {
+  return StreamValue(v);
+}
+
+std::string CheckOpValueStr(const std::string& v) {
+  return v;
+}
+
+std::string* MakeCheckOpStringFromValues(const std::string& v1,
+                                         const std::string& v2,
+                                         const char* names) {
+  std::string* msg = new std::string(names);
+  msg->append(" (");
+  msg->append(v1);
+  msg->append(" vs. ");
+  msg->append(v2);
+  msg->append(")");
+  return msg;
+}
+
+}  // namespace logging
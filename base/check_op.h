@@ -5,36 +5,65 @@
 #ifndef MINI_CHROMIUM_BASE_CHECK_OP_H_
 #define MINI_CHROMIUM_BASE_CHECK_OP_H_
 
+#include <sstream>
+#include <string>
+
 #include "base/check.h"
+#include "base/compiler_specific.h"
 #include "base/logging.h"
 
 namespace logging {
 
-template<typename t1, typename t2>
-std::string* MakeCheckOpString(const t1& v1, const t2& v2, const char* names) {
+// The failure path of CHECK_op is kept out of line and marked cold, so that
+// callers only contain the comparison and a call that is predicted not to be
+// taken. Operands are converted to strings by CheckOpValueStr(), whose
+// overloads for common types are defined once in check_op.cc, and the message
+// is then assembled by a single non-template function.
+
+NOINLINE COLD_FUNCTION std::string CheckOpValueStr(int v);
+NOINLINE COLD_FUNCTION std::string CheckOpValueStr(unsigned v);
+NOINLINE COLD_FUNCTION std::string CheckOpValueStr(long v);
+NOINLINE COLD_FUNCTION std::string CheckOpValueStr(unsigned long v);
+NOINLINE COLD_FUNCTION std::string CheckOpValueStr(long long v);
+NOINLINE COLD_FUNCTION std::string CheckOpValueStr(unsigned long long v);
+NOINLINE COLD_FUNCTION std::string CheckOpValueStr(double v);
+NOINLINE COLD_FUNCTION std::string CheckOpValueStr(const std::string& v);
+
+template <typename T>
+NOINLINE COLD_FUNCTION std::string CheckOpValueStr(const T& v) {
   std::ostringstream ss;
-  ss << names << " (" << v1 << " vs. " << v2 << ")";
-  std::string* msg = new std::string(ss.str());
-  return msg;
+  ss << v;
+  return ss.str();
+}
+
+NOINLINE COLD_FUNCTION std::string* MakeCheckOpStringFromValues(
+    const std::string& v1,
+    const std::string& v2,
+    const char* names);
+
+template <typename t1, typename t2>
+NOINLINE COLD_FUNCTION std::string* MakeCheckOpString(const t1& v1,
+                                                      const t2& v2,
+                                                      const char* names) {
+  return MakeCheckOpStringFromValues(
+      CheckOpValueStr(v1), CheckOpValueStr(v2), names);
 }
 
 #define DEFINE_CHECK_OP_IMPL(name, op) \
     template <typename t1, typename t2> \
     inline std::string* Check ## name ## Impl(const t1& v1, const t2& v2, \
                                               const char* names) { \
-      if (v1 op v2) { \
-        return NULL; \
-      } else { \
-        return MakeCheckOpString(v1, v2, names); \
+      if (v1 op v2) [[likely]] { \
+        return nullptr; \
       } \
+      return MakeCheckOpString(v1, v2, names); \
     } \
     inline std::string* Check ## name ## Impl(int v1, int v2, \
                                               const char* names) { \
-      if (v1 op v2) { \
-        return NULL; \
-      } else { \
-        return MakeCheckOpString(v1, v2, names); \
+      if (v1 op v2) [[likely]] { \
+        return nullptr; \
       } \
+      return MakeCheckOpString(v1, v2, names); \
     }
 
 DEFINE_CHECK_OP_IMPL(EQ, ==)
@@ -52,7 +81,7 @@ DEFINE_CHECK_OP_IMPL(GT, >)
     if (std::string* _result = \
           logging::Check ## name ## Impl((val1), (val2), \
                                          # val1 " " # op " " # val2)) \
-      logging::LogMessage(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
+      logging::LogMessage(FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, \
                           _result).stream()
 
 #define CHECK_EQ(val1, val2) CHECK_OP(EQ, ==, val1, val2)
@@ -68,7 +97,7 @@ DEFINE_CHECK_OP_IMPL(GT, >)
       if (std::string* _result = \
           logging::Check ## name ## Impl((val1), (val2), \
                                          # val1 " " # op " " # val2)) \
-        logging::LogMessage(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
+        logging::LogMessage(FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, \
                             _result).stream()
 
 #define DCHECK_EQ(val1, val2) DCHECK_OP(EQ, ==, val1, val2)
@@ -0,0 +1,46 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/check.h"
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "base/check_op.h"
+#include "testing/perf/perf_test.h"
+
+namespace logging {
+
+// The cost of checks that pass, which is all that a hot function pays for them.
+PERF_TEST(Check, PassPath) {
+  constexpr size_t kValues = 4096;
+  std::vector<int> values(kValues);
+  std::vector<int> copies(kValues);
+  for (size_t index = 0; index < kValues; ++index) {
+    values[index] = copies[index] = static_cast<int>(index);
+  }
+  const int limit = static_cast<int>(kValues);
+
+  const auto report = [](const char* story, auto check) {
+    const double ns = perf_test::MeasureNanosecondsPerCall([&] {
+      for (size_t index = 0; index < kValues; ++index) {
+        check(index);
+      }
+    });
+    perf_test::PrintResult("check_pass", story, ns / kValues, "ns_per_check");
+  };
+
+  report("none",
+         [&](size_t index) { perf_test::DoNotOptimize(values[index]); });
+  report("check", [&](size_t index) { CHECK(values[index] < limit); });
+  report("check_eq",
+         [&](size_t index) { CHECK_EQ(values[index], copies[index]); });
+  report("check_lt", [&](size_t index) { CHECK_LT(values[index], limit); });
+  report("dcheck", [&](size_t index) { DCHECK(values[index] < limit); });
+  report("dcheck_eq",
+         [&](size_t index) { DCHECK_EQ(values[index], copies[index]); });
+}
+
+}  // namespace logging
@@ -47,6 +47,17 @@
 #define NOINLINE
 #endif
 
+// Annotate a function indicating it is unlikely to be called. Branches leading
+// to calls to it are treated as unlikely, and the function itself is optimized
+// for size and placed away from hot code.
+// Use like:
+//   COLD_FUNCTION void ReportFailure() { ... }
+#if (defined(COMPILER_GCC) || defined(__clang__)) && HAS_ATTRIBUTE(cold)
+#define COLD_FUNCTION __attribute__((cold))
+#else
+#define COLD_FUNCTION
+#endif
+
 // Annotate a function indicating it should not be optimized.
 #if defined(__clang__) && HAS_ATTRIBUTE(optnone)
 #define NOOPT [[clang::optnone]]
@@ -0,0 +1,122 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/log_flight_recorder.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "base/posix/eintr_wrapper.h"
+
+namespace logging {
+namespace internal {
+
+namespace {
+
+constexpr size_t kSlotCount = 128;
+constexpr size_t kSlotSize = 512;
+constexpr size_t kSlotDataSize =
+    kSlotSize - sizeof(std::atomic<uint64_t>) - sizeof(uint32_t);
+
+static_assert((kSlotCount & (kSlotCount - 1)) == 0,
+              "kSlotCount must be a power of two");
+
+struct Slot {
+  // 0 while the slot has never been written. Otherwise, twice the position + 1
+  // of the message it holds, plus 1 while that message is being copied in.
+  std::atomic<uint64_t> state;
+  uint32_t length;
+  char data[kSlotDataSize];
+};
+
+static_assert(sizeof(Slot) == kSlotSize, "Slot must fill kSlotSize");
+
+// Storage for the ring is static, so recording never allocates.
+constinit Slot g_slots[kSlotCount];
+constinit std::atomic<uint64_t> g_next_position(0);
+constinit std::atomic<bool> g_dumped(false);
+
+void WriteAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t written = HANDLE_EINTR(write(fd, data, size));
+    if (written <= 0) {
+      return;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+}
+
+void WriteAll(int fd, std::string_view string) {
+  WriteAll(fd, string.data(), string.size());
+}
+
+}  // namespace
+
+// static
+void LogFlightRecorder::Record(std::string_view message) {
+  const uint64_t position =
+      g_next_position.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = g_slots[position % kSlotCount];
+
+  uint64_t state = slot.state.load(std::memory_order_relaxed);
+  if ((state & 1) != 0 ||
+      !slot.state.compare_exchange_strong(
+          state, state | 1, std::memory_order_acquire)) {
+    // Another thread is still writing to this slot, a full lap behind.
+    return;
+  }
+  // Keep the data writes below from being reordered before the state change
+  // that marks the slot as being written.
+  std::atomic_thread_fence(std::memory_order_release);
+
+  size_t length = std::min(message.size(), kSlotDataSize);
+  memcpy(slot.data, message.data(), length);
+  if (length < message.size()) {
+    slot.data[length - 1] = '\n';
+  }
+  slot.length = static_cast<uint32_t>(length);
+  slot.state.store((position + 1) * 2, std::memory_order_release);
+}
+
+// static
+void LogFlightRecorder::Dump(int fd) {
+  if (g_dumped.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+
+  const uint64_t end = g_next_position.load(std::memory_order_acquire);
+  const uint64_t begin = end > kSlotCount ? end - kSlotCount : 0;
+  if (begin == end) {
+    return;
+  }
+
+  WriteAll(fd, "--- Recent log messages ---\n");
+  for (uint64_t position = begin; position < end; ++position) {
+    const Slot& slot = g_slots[position % kSlotCount];
+    const uint64_t state = slot.state.load(std::memory_order_acquire);
+    if (state != (position + 1) * 2) {
+      // Never completed, being rewritten, or already overwritten.
+      continue;
+    }
+
+    char data[kSlotDataSize];
+    const size_t length = std::min<size_t>(slot.length, kSlotDataSize);
+    memcpy(data, slot.data, length);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.state.load(std::memory_order_relaxed) != state) {
+      continue;
+    }
+
+    WriteAll(fd, data, length);
+  }
+  WriteAll(fd, "--- End of recent log messages ---\n");
+}
+
+}  // namespace internal
+}  // namespace logging
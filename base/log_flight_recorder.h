@@ -0,0 +1,41 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_LOG_FLIGHT_RECORDER_H_
+#define MINI_CHROMIUM_BASE_LOG_FLIGHT_RECORDER_H_
+
+#include <string_view>
+
+namespace logging {
+namespace internal {
+
+// LogFlightRecorder keeps the most recent log messages in a preallocated
+// in-memory ring, so that they can be written out when the process is about to
+// crash. Messages are recorded at or above the level set by
+// SetFlightRecorderMinLevel(), which may be below the level at which messages
+// are output.
+//
+// Record() is lock-free. Each message claims the next slot of the ring with an
+// atomic increment, and is truncated to fit the slot. A slot that is still
+// being written when its turn comes around again is skipped rather than waited
+// for.
+//
+// Dump() only calls async-signal-safe functions and does not allocate, so it
+// may be called from a signal handler or on a thread that is crashing.
+class LogFlightRecorder {
+ public:
+  LogFlightRecorder() = delete;
+
+  // Copies |message|, which is expected to end in a newline, into the ring.
+  static void Record(std::string_view message);
+
+  // Writes the recorded messages, oldest first, to |fd|. Only the first call
+  // writes anything, so that a crash while crashing does not repeat the dump.
+  static void Dump(int fd);
+};
+
+}  // namespace internal
+}  // namespace logging
+
+#endif  // MINI_CHROMIUM_BASE_LOG_FLIGHT_RECORDER_H_
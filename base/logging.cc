@@ -6,15 +6,32 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iomanip>
+#include <limits>
+#include <memory>
 #include <ostream>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #if BUILDFLAG(IS_POSIX)
 #include <paths.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
+#include "base/async_log_writer.h"
+#include "base/binary_log.h"
+#include "base/files/file_path.h"
+#include "base/log_flight_recorder.h"
+#include "base/mapped_log_file.h"
 #include "base/posix/safe_strerror.h"
 #endif  // BUILDFLAG(IS_POSIX)
 
@@ -35,9 +52,13 @@
 
 #include "base/check_op.h"
 #include "base/immediate_crash.h"
+#include "base/strings/pattern.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_tokenizer.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/lock.h"
 
 namespace logging {
 
@@ -51,25 +72,600 @@ const char* const log_severity_names[] = {
   "FATAL"
 };
 
-LogMessageHandlerFunction g_log_message_handler = nullptr;
+std::atomic<LogMessageHandlerFunction> g_log_message_handler(nullptr);
 
 LoggingDestination g_logging_destination = LOG_DEFAULT;
 
+#if BUILDFLAG(IS_POSIX)
+std::atomic<internal::MappedLogFile*> g_log_file;
+
+// The log file locked by the thread calling fork(), so that the child replaces
+// the same one even if another thread has replaced |g_log_file| meanwhile.
+internal::MappedLogFile* g_log_file_at_fork;
+
+void LogFileAtForkPrepare() {
+  g_log_file_at_fork = g_log_file.load(std::memory_order_acquire);
+  if (g_log_file_at_fork) {
+    g_log_file_at_fork->AtForkPrepare();
+  }
+}
+
+void LogFileAtForkParent() {
+  if (g_log_file_at_fork) {
+    g_log_file_at_fork->AtForkParent();
+  }
+}
+
+void LogFileAtForkChild() {
+  if (g_log_file_at_fork) {
+    g_log_file.store(g_log_file_at_fork->AtForkChild(),
+                     std::memory_order_release);
+  }
+}
+#endif  // BUILDFLAG(IS_POSIX)
+
+#if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_FUCHSIA)
+
+// "[pid:tid:YYYYMMDD,HHMMSS.uuuuuu:", with room for 64-bit IDs.
+constexpr size_t kMaxLogHeaderLength = 1 + 20 + 1 + 20 + 1 + 15 + 1 + 6 + 1;
+
+// The parts of the log message header that change rarely, cached per thread so
+// that formatting a header doesn’t require a system call for the process and
+// thread IDs or a localtime_r() call, which may take a lock.
+struct LogHeaderCache {
+  // "[pid:tid:", valid while |fork_generation| is current.
+  char ids[1 + 20 + 1 + 20 + 1];
+  size_t ids_length;
+  bool ids_valid;
+  uint32_t fork_generation;
+
+  // "YYYYMMDD,HHMMSS" for the local time during |second|.
+  char time[15];
+  bool time_valid;
+  time_t second;
+};
+
+constinit thread_local LogHeaderCache g_log_header_cache = {};
+
+// Incremented in the child after fork() to invalidate cached IDs. Only the
+// thread that called fork() exists in the child, so only its cache matters.
+std::atomic<uint32_t> g_fork_generation;
+
+void IncrementForkGeneration() {
+  g_fork_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t ForkGeneration() {
+  [[maybe_unused]] static const bool registered = [] {
+    pthread_atfork(nullptr, nullptr, &IncrementForkGeneration);
+    return true;
+  }();
+  return g_fork_generation.load(std::memory_order_relaxed);
+}
+
+// Writes |value| in decimal to |out|, which must have room for 20 characters,
+// and returns the number of characters written.
+size_t FormatDecimal(uint64_t value, char* out) {
+  char digits[20];
+  size_t count = 0;
+  do {
+    digits[count++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  for (size_t index = 0; index < count; ++index) {
+    out[index] = digits[count - index - 1];
+  }
+  return count;
+}
+
+// Writes the low |width| decimal digits of |value| to |out|, zero-padded.
+void FormatZeroPadded(unsigned int value, size_t width, char* out) {
+  for (size_t index = width; index > 0; --index) {
+    out[index - 1] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+}
+
+// Formats the "[pid:tid:YYYYMMDD,HHMMSS.uuuuuu:" log message header into
+// |header|, which must have room for kMaxLogHeaderLength characters, and
+// returns its length. Except when the thread logs for the first time in a
+// process or in a new second, this only formats the microseconds.
+size_t FormatLogHeader(char* header) {
+  LogHeaderCache& cache = g_log_header_cache;
+
+  const uint32_t fork_generation = ForkGeneration();
+  if (!cache.ids_valid || cache.fork_generation != fork_generation) {
+    pid_t pid = getpid();
+#if BUILDFLAG(IS_APPLE)
+    uint64_t thread;
+    pthread_threadid_np(pthread_self(), &thread);
+#elif BUILDFLAG(IS_ANDROID)
+    pid_t thread = gettid();
+#elif BUILDFLAG(IS_LINUX)
+    pid_t thread = static_cast<pid_t>(syscall(__NR_gettid));
+#endif
+
+    char* out = cache.ids;
+    *out++ = '[';
+    out += FormatDecimal(static_cast<uint64_t>(pid), out);
+    *out++ = ':';
+    out += FormatDecimal(static_cast<uint64_t>(thread), out);
+    *out++ = ':';
+    cache.ids_length = static_cast<size_t>(out - cache.ids);
+    cache.fork_generation = fork_generation;
+    cache.ids_valid = true;
+  }
+
+  timeval tv;
+  gettimeofday(&tv, nullptr);
+  if (!cache.time_valid || cache.second != tv.tv_sec) {
+    tm local_time;
+    localtime_r(&tv.tv_sec, &local_time);
+    FormatZeroPadded(local_time.tm_year + 1900, 4, &cache.time[0]);
+    FormatZeroPadded(local_time.tm_mon + 1, 2, &cache.time[4]);
+    FormatZeroPadded(local_time.tm_mday, 2, &cache.time[6]);
+    cache.time[8] = ',';
+    FormatZeroPadded(local_time.tm_hour, 2, &cache.time[9]);
+    FormatZeroPadded(local_time.tm_min, 2, &cache.time[11]);
+    FormatZeroPadded(local_time.tm_sec, 2, &cache.time[13]);
+    cache.second = tv.tv_sec;
+    cache.time_valid = true;
+  }
+
+  char* out = header;
+  memcpy(out, cache.ids, cache.ids_length);
+  out += cache.ids_length;
+  memcpy(out, cache.time, sizeof(cache.time));
+  out += sizeof(cache.time);
+  *out++ = '.';
+  FormatZeroPadded(static_cast<unsigned int>(tv.tv_usec), 6, out);
+  out += 6;
+  *out++ = ':';
+  return static_cast<size_t>(out - header);
+}
+
+#endif  // BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_FUCHSIA)
+
+struct VmoduleEntry {
+  base::CompiledPattern pattern;
+  int level;
+  bool match_path;
+};
+
+// Guards g_vlog_level and g_vmodule, and is held while g_vlog_generation is
+// advanced so that a level resolved under the lock is tagged with the
+// generation of the settings it was resolved from.
+base::Lock& GetVlogLock() {
+  static base::Lock* const lock = new base::Lock();
+  return *lock;
+}
+
+int g_vlog_level = std::numeric_limits<int>::max();
+std::vector<VmoduleEntry>* g_vmodule = nullptr;
+
+bool ContainsPathSeparator(std::string_view string) {
+#if BUILDFLAG(IS_WIN)
+  return string.find_first_of("\\/") != std::string_view::npos;
+#else
+  return string.find('/') != std::string_view::npos;
+#endif
+}
+
+// Returns the base name of |file| without its extension or any “-inl” suffix.
+std::string_view GetModule(std::string_view file) {
+#if BUILDFLAG(IS_WIN)
+  const size_t last_slash = file.find_last_of("\\/");
+#else
+  const size_t last_slash = file.find_last_of('/');
+#endif
+  if (last_slash != std::string_view::npos) {
+    file.remove_prefix(last_slash + 1);
+  }
+  const size_t extension = file.rfind('.');
+  if (extension != std::string_view::npos) {
+    file.remove_suffix(file.size() - extension);
+  }
+  constexpr std::string_view kInlSuffix("-inl");
+  if (file.ends_with(kInlSuffix)) {
+    file.remove_suffix(kInlSuffix.size());
+  }
+  return file;
+}
+
+// The registered LogSinks. The list is immutable once published, and is
+// replaced as a whole when a sink is added or removed.
+struct LogSinkList {
+  struct Entry {
+    LogSink* sink;
+    LogSeverity min_severity;
+  };
+  std::vector<Entry> entries;
+};
+
+// Serializes changes to g_log_sinks.
+base::Lock& GetLogSinksLock() {
+  static base::Lock* const lock = new base::Lock();
+  return *lock;
+}
+
+// Readers of g_log_sinks announce themselves in one of two counters, chosen by
+// the low bit of g_log_sinks_epoch, without taking any lock. A writer publishes
+// a new list, then waits for a grace period in which every reader that might
+// still hold the old list has finished, before deleting it.
+std::atomic<const LogSinkList*> g_log_sinks(nullptr);
+std::atomic<uint32_t> g_log_sinks_epoch(0);
+std::atomic<uint32_t> g_log_sinks_readers[2];
+
+// Calls every registered sink interested in |severity|.
+void SendToLogSinks(LogSeverity severity,
+                    const char* file_path,
+                    int line,
+                    size_t message_start,
+                    std::string_view message) {
+  if (!g_log_sinks.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  std::atomic<uint32_t>& readers =
+      g_log_sinks_readers[g_log_sinks_epoch.load(std::memory_order_relaxed) &
+                          1];
+  readers.fetch_add(1, std::memory_order_seq_cst);
+  if (const LogSinkList* sinks = g_log_sinks.load(std::memory_order_seq_cst)) {
+    for (const LogSinkList::Entry& entry : sinks->entries) {
+      if (severity >= entry.min_severity) {
+        entry.sink->Send(severity, file_path, line, message_start, message);
+      }
+    }
+  }
+  readers.fetch_sub(1, std::memory_order_release);
+}
+
+// Publishes |sinks| and deletes the previous list once no reader can be using
+// it.
+void ReplaceLogSinksLocked(std::unique_ptr<LogSinkList> sinks) {
+  GetLogSinksLock().AssertAcquired();
+
+  std::unique_ptr<const LogSinkList> old_sinks(
+      g_log_sinks.exchange(sinks.release(), std::memory_order_seq_cst));
+
+  // Any reader that could have loaded |old_sinks| incremented one of the two
+  // counters before the exchange above, and keeps it nonzero until it is done.
+  // Waiting for each counter to drain in turn, after flipping the epoch so that
+  // new readers use the other counter, waits out every such reader without
+  // being starved by new ones.
+  //
+  // The counter loads are seq_cst so that they are ordered with the exchange
+  // and with each reader’s seq_cst increment and load of g_log_sinks: if the
+  // reader’s load came first and saw |old_sinks|, its increment precedes this
+  // load in the single total order, so this load sees it. The reader’s release
+  // decrement then orders its use of the list before the deletion.
+  for (int flip = 0; flip < 2; ++flip) {
+    const uint32_t epoch =
+        g_log_sinks_epoch.fetch_add(1, std::memory_order_seq_cst);
+    while (g_log_sinks_readers[epoch & 1].load(std::memory_order_seq_cst) !=
+           0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+int64_t SteadyClockNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// The LogSiteStats of every statement that has logged with accounting
+// enabled. Statements are pushed onto the front, and never removed.
+std::atomic<internal::LogSiteStats*> g_log_sites(nullptr);
+
+// In nanoseconds on SteadyClockNanoseconds(), or 0 when disabled.
+std::atomic<int64_t> g_log_site_dump_interval(0);
+std::atomic<int64_t> g_next_log_site_dump_time(0);
+
+#if BUILDFLAG(IS_POSIX)
+std::atomic<int> g_flight_recorder_min_level(LOG_INFO);
+#endif  // BUILDFLAG(IS_POSIX)
+
+void UpdateMinCaptureLevel() {
+  int level = GetMinLogLevel();
+#if BUILDFLAG(IS_POSIX)
+  level = std::min(level,
+                   g_flight_recorder_min_level.load(std::memory_order_relaxed));
+#endif  // BUILDFLAG(IS_POSIX)
+  internal::g_min_capture_level.store(level, std::memory_order_relaxed);
+}
+
+int GetVlogLevelLocked(const char* file) {
+  GetVlogLock().AssertAcquired();
+
+  if (g_vmodule) {
+    const std::string_view path(file);
+    const std::string_view module = GetModule(path);
+    for (const VmoduleEntry& entry : *g_vmodule) {
+      if (entry.pattern.Match(entry.match_path ? path : module)) {
+        return entry.level;
+      }
+    }
+  }
+  return g_vlog_level;
+}
+
 }  // namespace
 
+namespace internal {
+
+std::atomic<int> g_min_log_level(LOG_INFO);
+std::atomic<int> g_min_capture_level(LOG_INFO);
+std::atomic<uint32_t> g_vlog_generation(1);
+
+int VlogSite::Resolve(const char* file) {
+  base::AutoLock lock(GetVlogLock());
+  const uint32_t generation = g_vlog_generation.load(std::memory_order_relaxed);
+  const int level = GetVlogLevelLocked(file);
+  state_.store((uint64_t{generation} << 32) | static_cast<uint32_t>(level),
+               std::memory_order_relaxed);
+  return level;
+}
+
+bool LogEveryNSecState::ShouldLog(double seconds, uint64_t* suppressed) {
+  const int64_t now = SteadyClockNanoseconds();
+  int64_t next_log_time = next_log_time_.load(std::memory_order_relaxed);
+  if (now < next_log_time ||
+      !next_log_time_.compare_exchange_strong(
+          next_log_time, now + static_cast<int64_t>(seconds * 1e9),
+          std::memory_order_relaxed)) {
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  *suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+  return true;
+}
+
+std::atomic<bool> g_log_site_accounting(false);
+constinit thread_local LogSiteStats* g_pending_log_site = nullptr;
+
+void LogSiteStats::Register(LogSeverity severity) {
+  // If several threads race here, only the first registers the statement. The
+  // others count their messages in the meantime, which is seen once it has.
+  if (claimed_.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+  severity_ = severity;
+  next_ = g_log_sites.load(std::memory_order_relaxed);
+  while (!g_log_sites.compare_exchange_weak(
+      next_, this, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  registered_.store(true, std::memory_order_relaxed);
+}
+
+// static
+void LogSiteStats::MaybeDumpVolumes() {
+  // Only look at the clock every so often.
+  constexpr uint32_t kMarksPerClockCheck = 256;
+  constinit thread_local uint32_t marks = 0;
+  if (++marks % kMarksPerClockCheck != 0) [[likely]] {
+    return;
+  }
+
+  const int64_t interval =
+      g_log_site_dump_interval.load(std::memory_order_relaxed);
+  if (interval == 0) {
+    return;
+  }
+  const int64_t now = SteadyClockNanoseconds();
+  int64_t next_dump_time =
+      g_next_log_site_dump_time.load(std::memory_order_relaxed);
+  if (now < next_dump_time ||
+      !g_next_log_site_dump_time.compare_exchange_strong(
+          next_dump_time, now + interval, std::memory_order_relaxed)) {
+    return;
+  }
+
+  constexpr size_t kMaxSitesDumped = 10;
+  std::vector<LogSiteVolume> volumes = GetLogSiteVolumes(/*reset=*/true);
+  const size_t count = std::min(volumes.size(), kMaxSitesDumped);
+  std::partial_sort(volumes.begin(),
+                    volumes.begin() + count,
+                    volumes.end(),
+                    [](const LogSiteVolume& a, const LogSiteVolume& b) {
+                      return a.bytes > b.bytes;
+                    });
+
+  LogMessage message(FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, LOG_INFO);
+  message.stream() << "Log volume by statement over the last "
+                   << interval / 1000000000.0 << " s:";
+  for (size_t index = 0; index < count; ++index) {
+    const LogSiteVolume& volume = volumes[index];
+    message.stream() << "\n  " << volume.file << ':' << volume.line << ' '
+                     << (volume.severity >= 0 ? log_severity_names[std::min(
+                                                    volume.severity, LOG_FATAL)]
+                                              : "VERBOSE")
+                     << ": " << volume.messages << " messages, "
+                     << volume.bytes << " bytes";
+  }
+}
+
+}  // namespace internal
+
+void SetMinLogLevel(int level) {
+  internal::g_min_log_level.store(std::min(level, LOG_FATAL),
+                                  std::memory_order_relaxed);
+  UpdateMinCaptureLevel();
+}
+
+void SetFlightRecorderMinLevel(int level) {
+#if BUILDFLAG(IS_POSIX)
+  g_flight_recorder_min_level.store(level, std::memory_order_relaxed);
+  UpdateMinCaptureLevel();
+#endif  // BUILDFLAG(IS_POSIX)
+}
+
+void SetVlogLevel(int level) {
+  base::AutoLock lock(GetVlogLock());
+  g_vlog_level = level;
+  internal::g_vlog_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool SetVmodule(std::string_view vmodule) {
+  auto entries = std::make_unique<std::vector<VmoduleEntry>>();
+  for (const std::string_view entry : base::StringViewTokenizer(vmodule, ",")) {
+    const size_t equals = entry.rfind('=');
+    int level;
+    if (equals == 0 || equals == std::string_view::npos ||
+        !base::StringToInt(entry.substr(equals + 1), &level)) {
+      return false;
+    }
+    const std::string_view pattern = entry.substr(0, equals);
+    entries->push_back({base::CompiledPattern(pattern), level,
+                        ContainsPathSeparator(pattern)});
+  }
+
+  base::AutoLock lock(GetVlogLock());
+  delete g_vmodule;
+  g_vmodule = entries->empty() ? nullptr : entries.release();
+  internal::g_vlog_generation.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+int GetVlogLevel(const char* file) {
+  base::AutoLock lock(GetVlogLock());
+  return GetVlogLevelLocked(file);
+}
+
+void SetLogSiteAccountingEnabled(bool enabled) {
+  internal::g_log_site_accounting.store(enabled, std::memory_order_relaxed);
+}
+
+std::vector<LogSiteVolume> GetLogSiteVolumes(bool reset) {
+  std::vector<LogSiteVolume> volumes;
+  for (const internal::LogSiteStats* site =
+           g_log_sites.load(std::memory_order_acquire);
+       site;
+       site = site->next_) {
+    internal::LogSiteStats* const mutable_site =
+        const_cast<internal::LogSiteStats*>(site);
+    const uint64_t messages =
+        reset ? mutable_site->messages_.exchange(0, std::memory_order_relaxed)
+              : site->messages_.load(std::memory_order_relaxed);
+    const uint64_t bytes =
+        reset ? mutable_site->bytes_.exchange(0, std::memory_order_relaxed)
+              : site->bytes_.load(std::memory_order_relaxed);
+    if (messages != 0 || bytes != 0) {
+      volumes.push_back(
+          {site->file_, site->line_, site->severity_, messages, bytes});
+    }
+  }
+  return volumes;
+}
+
+void SetLogSiteVolumeDumpInterval(double seconds) {
+  const int64_t interval =
+      seconds > 0 ? std::max<int64_t>(static_cast<int64_t>(seconds * 1e9), 1)
+                  : 0;
+  g_log_site_dump_interval.store(interval, std::memory_order_relaxed);
+  g_next_log_site_dump_time.store(SteadyClockNanoseconds() + interval,
+                                  std::memory_order_relaxed);
+}
+
 bool InitLogging(const LoggingSettings& settings) {
+#if BUILDFLAG(IS_POSIX)
+  if ((settings.logging_dest & LOG_TO_FILE) != 0 && !settings.log_file_path) {
+    return false;
+  }
+
+  // The previous file is closed first, so that if it is the same file, the new
+  // one can take the lock on it and map it. It is intentionally leaked, because
+  // another thread may still be using it.
+  internal::MappedLogFile* old_log_file =
+      g_log_file.load(std::memory_order_acquire);
+  if (old_log_file) {
+    old_log_file->Close();
+  }
+
+  internal::MappedLogFile* log_file = nullptr;
+  if ((settings.logging_dest & LOG_TO_FILE) != 0) {
+    log_file = new internal::MappedLogFile(
+        base::FilePath(settings.log_file_path),
+        settings.max_log_file_size,
+        settings.max_log_file_count);
+    if (!log_file->Open()) {
+      delete log_file;
+      if (old_log_file) {
+        old_log_file->Open();
+      }
+      return false;
+    }
+
+    [[maybe_unused]] static bool registered = [] {
+      pthread_atfork(
+          &LogFileAtForkPrepare, &LogFileAtForkParent, &LogFileAtForkChild);
+      return true;
+    }();
+  }
+  g_log_file.store(log_file, std::memory_order_release);
+#else
   DCHECK_EQ(settings.logging_dest & LOG_TO_FILE, 0u);
+#endif  // BUILDFLAG(IS_POSIX)
 
   g_logging_destination = settings.logging_dest;
+
+#if BUILDFLAG(IS_POSIX)
+  if (settings.write_mode == LogWriteMode::kAsynchronous) {
+    return internal::AsyncLogWriter::Start(STDERR_FILENO,
+                                           settings.async_buffer_size,
+                                           settings.async_overflow_policy);
+  }
+  internal::AsyncLogWriter::Stop();
+#endif  // BUILDFLAG(IS_POSIX)
+
   return true;
 }
 
 void SetLogMessageHandler(LogMessageHandlerFunction log_message_handler) {
-  g_log_message_handler = log_message_handler;
+  g_log_message_handler.store(log_message_handler, std::memory_order_release);
 }
 
 LogMessageHandlerFunction GetLogMessageHandler() {
-  return g_log_message_handler;
+  return g_log_message_handler.load(std::memory_order_acquire);
+}
+
+LogSink::~LogSink() = default;
+
+void AddLogSink(LogSink* sink, LogSeverity min_severity) {
+  base::AutoLock lock(GetLogSinksLock());
+  auto sinks = std::make_unique<LogSinkList>();
+  if (const LogSinkList* old_sinks =
+          g_log_sinks.load(std::memory_order_relaxed)) {
+    sinks->entries = old_sinks->entries;
+  }
+  auto it = std::find_if(
+      sinks->entries.begin(), sinks->entries.end(),
+      [sink](const LogSinkList::Entry& entry) { return entry.sink == sink; });
+  if (it != sinks->entries.end()) {
+    it->min_severity = min_severity;
+  } else {
+    sinks->entries.push_back({sink, min_severity});
+  }
+  ReplaceLogSinksLocked(std::move(sinks));
+}
+
+void RemoveLogSink(LogSink* sink) {
+  base::AutoLock lock(GetLogSinksLock());
+  const LogSinkList* old_sinks = g_log_sinks.load(std::memory_order_relaxed);
+  if (!old_sinks) {
+    return;
+  }
+  auto sinks = std::make_unique<LogSinkList>();
+  for (const LogSinkList::Entry& entry : old_sinks->entries) {
+    if (entry.sink != sink) {
+      sinks->entries.push_back(entry);
+    }
+  }
+  if (sinks->entries.size() == old_sinks->entries.size()) {
+    return;
+  }
+  ReplaceLogSinksLocked(sinks->entries.empty() ? nullptr : std::move(sinks));
 }
 
 #if BUILDFLAG(IS_WIN)
@@ -99,11 +695,78 @@ std::string SystemErrorCodeToString(unsigned long error_code) {
 }
 #endif  // BUILDFLAG(IS_WIN)
 
+namespace internal {
+
+LogStreamBuf::LogStreamBuf() {
+  setp(inline_buffer_, inline_buffer_ + sizeof(inline_buffer_));
+}
+
+LogStreamBuf::~LogStreamBuf() = default;
+
+std::string_view LogStreamBuf::str() {
+  Reserve(1);
+  *pptr() = '\0';
+  return std::string_view(pbase(), size());
+}
+
+LogStreamBuf::int_type LogStreamBuf::overflow(int_type ch) {
+  if (traits_type::eq_int_type(ch, traits_type::eof())) {
+    return traits_type::not_eof(ch);
+  }
+  Reserve(1);
+  *pptr() = traits_type::to_char_type(ch);
+  Advance(1);
+  return ch;
+}
+
+std::streamsize LogStreamBuf::xsputn(const char* s, std::streamsize n) {
+  if (n <= 0) {
+    return 0;
+  }
+  const size_t count = static_cast<size_t>(n);
+  Reserve(count);
+  memcpy(pptr(), s, count);
+  Advance(count);
+  return n;
+}
+
+void LogStreamBuf::Reserve(size_t additional) {
+  const size_t used = size();
+  const size_t capacity = static_cast<size_t>(epptr() - pbase());
+  if (capacity - used >= additional) {
+    return;
+  }
+
+  const size_t new_capacity = std::max(used + additional, capacity * 2);
+  if (pbase() == inline_buffer_) {
+    spill_.resize(new_capacity);
+    memcpy(spill_.data(), inline_buffer_, used);
+  } else {
+    spill_.resize(new_capacity);
+  }
+  setp(spill_.data(), spill_.data() + spill_.size());
+  Advance(used);
+}
+
+void LogStreamBuf::Advance(size_t count) {
+  // pbump() takes an int.
+  while (count > 0) {
+    const int step = static_cast<int>(
+        std::min(count, static_cast<size_t>(std::numeric_limits<int>::max())));
+    pbump(step);
+    count -= step;
+  }
+}
+
+}  // namespace internal
+
 LogMessage::LogMessage(const char* function,
                        const char* file_path,
                        int line,
                        LogSeverity severity)
-    : stream_(),
+    : buffer_(),
+      stream_(&buffer_),
+      site_stats_(std::exchange(internal::g_pending_log_site, nullptr)),
       file_path_(file_path),
       message_start_(0),
       line_(line),
@@ -115,7 +778,9 @@ LogMessage::LogMessage(const char* function,
                        const char* file_path,
                        int line,
                        std::string* result)
-    : stream_(),
+    : buffer_(),
+      stream_(&buffer_),
+      site_stats_(std::exchange(internal::g_pending_log_site, nullptr)),
       file_path_(file_path),
       message_start_(0),
       line_(line),
@@ -130,20 +795,73 @@ LogMessage::~LogMessage() {
 }
 
 void LogMessage::Flush() {
-  stream_ << std::endl;
-  std::string str_newline(stream_.str());
+  stream_ << '\n';
+  const std::string_view str_newline = buffer_.str();
+
+#if BUILDFLAG(IS_POSIX)
+  internal::AsyncLogWriter* async_writer = internal::AsyncLogWriter::Get();
+  if (async_writer && severity_ == LOG_FATAL) {
+    // A FATAL message is about to crash the process, so anything still queued
+    // must be written now, on this thread, ahead of it.
+    async_writer->Drain();
+  }
 
-  if (g_log_message_handler &&
-      g_log_message_handler(
-          severity_, file_path_, line_, message_start_, str_newline)) {
+  if (severity_ == LOG_FATAL) {
+    FlushBinaryLog();
+    internal::LogFlightRecorder::Dump(STDERR_FILENO);
+  } else if (severity_ >=
+             g_flight_recorder_min_level.load(std::memory_order_relaxed)) {
+    internal::LogFlightRecorder::Record(str_newline);
+  }
+#endif  // BUILDFLAG(IS_POSIX)
+
+  if (severity_ >= 0 && severity_ < GetMinLogLevel()) {
+    // Formatted only for the flight recorder. VLOG messages are enabled by
+    // their own levels, and are not subject to the minimum log level.
+    return;
+  }
+
+  if (site_stats_) {
+    site_stats_->AddBytes(str_newline.size());
+  }
+
+  SendToLogSinks(severity_, file_path_, line_, message_start_, str_newline);
+
+  if (const LogMessageHandlerFunction log_message_handler =
+          g_log_message_handler.load(std::memory_order_acquire);
+      log_message_handler &&
+      log_message_handler(severity_,
+                          file_path_,
+                          line_,
+                          message_start_,
+                          std::string(str_newline))) {
     return;
   }
 
   if ((g_logging_destination & LOG_TO_STDERR)) {
-    fprintf(stderr, "%s", str_newline.c_str());
+#if BUILDFLAG(IS_POSIX)
+    if (async_writer && severity_ != LOG_FATAL) {
+      async_writer->Write(str_newline);
+    } else {
+      fwrite(str_newline.data(), 1, str_newline.size(), stderr);
+      fflush(stderr);
+    }
+#else
+    fwrite(str_newline.data(), 1, str_newline.size(), stderr);
     fflush(stderr);
+#endif  // BUILDFLAG(IS_POSIX)
   }
 
+#if BUILDFLAG(IS_POSIX)
+  if ((g_logging_destination & LOG_TO_FILE) != 0) {
+    internal::MappedLogFile* log_file =
+        g_log_file.load(std::memory_order_acquire);
+    if (log_file) {
+      log_file->Write(str_newline);
+    }
+  }
+#endif  // BUILDFLAG(IS_POSIX)
+
   if ((g_logging_destination & LOG_TO_SYSTEM_DEBUG_LOG) != 0) {
 #if BUILDFLAG(IS_APPLE)
     const bool log_to_system = []() {
@@ -227,7 +945,7 @@ void LogMessage::Flush() {
       }(severity_);
 
       os_log_with_type(
-          log.get(), os_log_type, "%{public}s", str_newline.c_str());
+          log.get(), os_log_type, "%{public}s", str_newline.data());
     }
 #elif BUILDFLAG(IS_WIN)
     OutputDebugString(base::UTF8ToWide(str_newline).c_str());
@@ -249,7 +967,7 @@ void LogMessage::Flush() {
         break;
     }
     // The Android system may truncate the string if it's too long.
-    __android_log_write(priority, "chromium", str_newline.c_str());
+    __android_log_write(priority, "chromium", str_newline.data());
 #elif BUILDFLAG(IS_FUCHSIA)
     fuchsia_logging::LogSeverity fx_severity;
     switch (severity_) {
@@ -288,62 +1006,32 @@ void LogMessage::Flush() {
 }
 
 void LogMessage::Init(const char* function) {
-  std::string file_name(file_path_);
+  std::string_view file_name(file_path_);
 #if BUILDFLAG(IS_WIN)
   size_t last_slash = file_name.find_last_of("\\/");
 #else
   size_t last_slash = file_name.find_last_of('/');
 #endif
-  if (last_slash != std::string::npos) {
-    file_name.assign(file_name.substr(last_slash + 1));
+  if (last_slash != std::string_view::npos) {
+    file_name.remove_prefix(last_slash + 1);
   }
 
+  // On Fuchsia, the platform is responsible for adding the process id, thread
+  // id, and log timestamp, not the process itself.
 #if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_FUCHSIA)
-  pid_t pid = getpid();
+  char header[kMaxLogHeaderLength];
+  stream_.write(header, FormatLogHeader(header));
+  stream_.fill('0');
 #elif BUILDFLAG(IS_WIN)
   DWORD pid = GetCurrentProcessId();
-#endif
-
-#if BUILDFLAG(IS_APPLE)
-  uint64_t thread;
-  pthread_threadid_np(pthread_self(), &thread);
-#elif BUILDFLAG(IS_ANDROID)
-  pid_t thread = gettid();
-#elif BUILDFLAG(IS_LINUX)
-  pid_t thread = static_cast<pid_t>(syscall(__NR_gettid));
-#elif BUILDFLAG(IS_WIN)
   DWORD thread = GetCurrentThreadId();
-#endif
-
-  // On Fuchsia, the platform is responsible for adding the process id and
-  // thread id, not the process itself.
-#if !BUILDFLAG(IS_FUCHSIA)
   stream_ << '['
           << pid
           << ':'
           << thread
           << ':'
           << std::setfill('0');
-#endif
 
-  // On Fuchsia, the platform is responsible for adding the log timestamp,
-  // not the process itself.
-#if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_FUCHSIA)
-  timeval tv;
-  gettimeofday(&tv, nullptr);
-  tm local_time;
-  localtime_r(&tv.tv_sec, &local_time);
-  stream_ << std::setw(4) << local_time.tm_year + 1900
-          << std::setw(2) << local_time.tm_mon + 1
-          << std::setw(2) << local_time.tm_mday
-          << ','
-          << std::setw(2) << local_time.tm_hour
-          << std::setw(2) << local_time.tm_min
-          << std::setw(2) << local_time.tm_sec
-          << '.'
-          << std::setw(6) << tv.tv_usec
-          << ':';
-#elif BUILDFLAG(IS_WIN)
   SYSTEMTIME local_time;
   GetLocalTime(&local_time);
   stream_ << std::setw(4) << local_time.wYear
@@ -380,7 +1068,7 @@ void LogMessage::Init(const char* function) {
   }
 #endif
 
-  message_start_ = stream_.str().size();
+  message_start_ = buffer_.size();
 }
 
 // We intentionally don't return from these destructors. Disable MSVC's warning
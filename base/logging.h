@@ -6,12 +6,19 @@
 #define MINI_CHROMIUM_BASE_LOGGING_H_
 
 #include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <limits>
+#include <ostream>
 #include <sstream>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "base/logging_buildflags.h"
 #include "build/build_config.h"
 
 namespace logging {
@@ -40,13 +47,64 @@ enum : LoggingDestination {
 #endif
 };
 
+// The character type of LoggingSettings::log_file_path.
+#if BUILDFLAG(IS_WIN)
+typedef wchar_t PathChar;
+#else
+typedef char PathChar;
+#endif
+
+// Specifies how messages destined for stderr are written.
+enum class LogWriteMode {
+  // Each message is written to stderr by the thread that logs it, before the
+  // logging statement completes.
+  kSynchronous,
+
+  // Each message is copied into a bounded in-memory queue and written to
+  // stderr by a dedicated background thread. FATAL messages drain the queue
+  // and are then written synchronously, so nothing queued ahead of a crash is
+  // lost. Only supported on POSIX; elsewhere this behaves as kSynchronous.
+  kAsynchronous,
+};
+
+// Specifies what happens to a message logged in LogWriteMode::kAsynchronous
+// when the queue is full.
+enum class AsyncLogOverflowPolicy {
+  // The logging thread waits for the background thread to make room.
+  kBlock,
+
+  // The message is discarded. The number of discarded messages is reported
+  // once the background thread catches up.
+  kDrop,
+};
+
 struct LoggingSettings {
   LoggingDestination logging_dest = LOG_DEFAULT;
+
+  // The file written to by LOG_TO_FILE, which is required when it is set. The
+  // file is appended to if it already exists. LOG_TO_FILE is only supported on
+  // POSIX.
+  const PathChar* log_file_path = nullptr;
+
+  // When nonzero, a message that would grow the log file beyond this many bytes
+  // first rotates it, renaming “debug.log” to “debug.log.1”, “debug.log.1” to
+  // “debug.log.2”, and so on, and starting a new “debug.log”.
+  size_t max_log_file_size = 0;
+
+  // The number of log files kept by rotation, including the current one.
+  size_t max_log_file_count = 5;
+
+  LogWriteMode write_mode = LogWriteMode::kSynchronous;
+  AsyncLogOverflowPolicy async_overflow_policy = AsyncLogOverflowPolicy::kBlock;
+
+  // The size of the queue used in LogWriteMode::kAsynchronous, in bytes. Only
+  // the first InitLogging() call that enables asynchronous mode uses this.
+  size_t async_buffer_size = 256 * 1024;
 };
 
-// Sets the logging destination.
-//
-// TODO(jperaza): LOG_TO_FILE is not yet supported.
+// Sets the logging destination and how messages are written to it. Returns
+// false if the log file could not be opened or a background thread could not be
+// started.
 bool InitLogging(const LoggingSettings& settings);
 
 typedef int LogSeverity;
@@ -73,14 +131,210 @@ typedef bool (*LogMessageHandlerFunction)(LogSeverity severity,
 void SetLogMessageHandler(LogMessageHandlerFunction log_message_handler);
 LogMessageHandlerFunction GetLogMessageHandler();
 
-static inline int GetMinLogLevel() {
-  return LOG_INFO;
+// A destination for log messages, in addition to those selected by
+// LoggingSettings::logging_dest. Any number of sinks may be registered, each
+// with its own minimum severity.
+class LogSink {
+ public:
+  virtual ~LogSink();
+
+  // Called for each message at or above the sink’s minimum severity, possibly
+  // on several threads at once. |message| is the formatted message, including
+  // its header and trailing newline, and the message text begins at
+  // |message_start|. The same formatted message is shared by every sink, and is
+  // only valid for the duration of the call. Send() must not call AddLogSink()
+  // or RemoveLogSink().
+  virtual void Send(LogSeverity severity,
+                    const char* file_path,
+                    int line,
+                    size_t message_start,
+                    std::string_view message) = 0;
+};
+
+// Registers |sink| to receive messages at or above |min_severity|, which may be
+// negative to receive VLOG messages. Messages are also subject to the minimum
+// log level. Registering a sink that is already registered changes its minimum
+// severity. |sink| must remain valid until it is removed.
+void AddLogSink(LogSink* sink, LogSeverity min_severity);
+
+// Unregisters |sink|. When this returns, no thread is still calling into
+// |sink|, so it may be destroyed.
+void RemoveLogSink(LogSink* sink);
+
+namespace internal {
+
+extern std::atomic<int> g_min_log_level;
+extern std::atomic<int> g_min_capture_level;
+extern std::atomic<uint32_t> g_vlog_generation;
+
+// Caches the VLOG level resolved for one VLOG_IS_ON() callsite. The cached
+// level is tagged with the value of g_vlog_generation it was resolved under,
+// and is resolved again once SetVlogLevel() or SetVmodule() advances it.
+class VlogSite {
+ public:
+  constexpr VlogSite() : state_(0) {}
+
+  VlogSite(const VlogSite&) = delete;
+  VlogSite& operator=(const VlogSite&) = delete;
+
+  int Level(const char* file) {
+    const uint64_t state = state_.load(std::memory_order_relaxed);
+    if (static_cast<uint32_t>(state >> 32) ==
+        g_vlog_generation.load(std::memory_order_relaxed)) [[likely]] {
+      return static_cast<int32_t>(static_cast<uint32_t>(state));
+    }
+    return Resolve(file);
+  }
+
+ private:
+  int Resolve(const char* file);
+
+  // The generation in the high 32 bits, and the level in the low 32 bits.
+  std::atomic<uint64_t> state_;
+};
+
+}  // namespace internal
+
+// Sets the log level. Messages at or above this level are logged, and anything
+// below it is silently ignored. The log level defaults to LOG_INFO. LOG(FATAL)
+// is always logged.
+void SetMinLogLevel(int level);
+
+inline int GetMinLogLevel() {
+  return internal::g_min_log_level.load(std::memory_order_relaxed);
+}
+
+// Sets the level at or above which messages are kept in the flight recorder, an
+// in-memory ring of recent messages that is written to stderr when a FATAL
+// message crashes the process. This may be below the minimum log level, in
+// which case messages between the two levels are formatted and recorded but not
+// output. The level defaults to LOG_INFO, and a level above LOG_FATAL disables
+// the flight recorder. The flight recorder is only supported on POSIX.
+void SetFlightRecorderMinLevel(int level);
+
+namespace internal {
+
+// The lower of the minimum log level and the flight recorder level. Messages
+// below this level are not formatted at all.
+inline int GetMinCaptureLevel() {
+  return g_min_capture_level.load(std::memory_order_relaxed);
 }
 
-static inline int GetVlogLevel(const char*) {
-  return std::numeric_limits<int>::max();
+}  // namespace internal
+
+// Sets the VLOG level for files not matched by a SetVmodule() pattern. VLOG(n)
+// is enabled when n is less than or equal to the level for its file. By
+// default, all VLOGs are enabled.
+void SetVlogLevel(int level);
+
+// Sets per-file VLOG levels, overriding SetVlogLevel(). |vmodule| has the
+// syntax of the --vmodule switch: a comma-separated list of <pattern>=<level>
+// entries, such as "file_path=2,net/*=1". A pattern containing a path separator
+// is matched against the whole __FILE__ path; otherwise, it is matched against
+// the file’s base name without its extension or any “-inl” suffix. Patterns
+// are matched with base::MatchPattern(), and the first matching entry wins.
+// Returns false without changing anything if |vmodule| is malformed.
+bool SetVmodule(std::string_view vmodule);
+
+// Returns the VLOG level for |file|. VLOG_IS_ON() caches this per callsite.
+int GetVlogLevel(const char* file);
+
+// Log volume accounting. When enabled, each LOG(), PLOG() and VLOG() statement
+// that produces a message counts the messages and bytes it has logged, so that
+// the statements responsible for most of the log can be found. Only messages
+// that pass the minimum log level are counted. Accounting is disabled by
+// default, and costs one relaxed atomic load per message while disabled.
+
+// The volume logged by one statement since accounting was enabled or last
+// reset.
+struct LogSiteVolume {
+  const char* file;
+  int line;
+  LogSeverity severity;
+  uint64_t messages;
+  uint64_t bytes;
+};
+
+void SetLogSiteAccountingEnabled(bool enabled);
+
+// Returns the volume logged by each statement that has logged anything, in no
+// particular order. If |reset| is true, each statement’s counters are reset as
+// they are read.
+std::vector<LogSiteVolume> GetLogSiteVolumes(bool reset);
+
+// When |seconds| is positive, the statements that logged the most bytes are
+// logged at LOG_INFO every |seconds| while accounting is enabled, and all
+// counters are then reset. The check is made by threads as they log, so no
+// summary is logged while nothing else is. Zero disables the summary.
+void SetLogSiteVolumeDumpInterval(double seconds);
+
+namespace internal {
+
+class LogSiteStats;
+
+extern std::atomic<bool> g_log_site_accounting;
+extern constinit thread_local LogSiteStats* g_pending_log_site;
+
+// The counters for one statement. Statements register their LogSiteStats in a
+// lock-free global list the first time they log with accounting enabled.
+class LogSiteStats {
+ public:
+  constexpr LogSiteStats(const char* file, int line)
+      : file_(file),
+        line_(line),
+        severity_(0),
+        claimed_(false),
+        registered_(false),
+        messages_(0),
+        bytes_(0),
+        next_(nullptr) {}
+
+  LogSiteStats(const LogSiteStats&) = delete;
+  LogSiteStats& operator=(const LogSiteStats&) = delete;
+
+  // Counts a message about to be logged at |severity|, and arranges for the
+  // LogMessage that the calling thread constructs next to count its bytes.
+  void Mark(LogSeverity severity) {
+    if (severity >= 0 && severity < GetMinLogLevel()) {
+      // Only formatted for the flight recorder.
+      return;
+    }
+    if (!registered_.load(std::memory_order_relaxed)) [[unlikely]] {
+      Register(severity);
+    }
+    messages_.fetch_add(1, std::memory_order_relaxed);
+    MaybeDumpVolumes();
+    g_pending_log_site = this;
+  }
+
+  void AddBytes(size_t bytes) {
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+ private:
+  friend std::vector<LogSiteVolume> logging::GetLogSiteVolumes(bool reset);
+
+  void Register(LogSeverity severity);
+
+  // Logs and resets the volumes if the dump interval has passed.
+  static void MaybeDumpVolumes();
+
+  const char* const file_;
+  const int line_;
+  LogSeverity severity_;
+  std::atomic<bool> claimed_;
+  std::atomic<bool> registered_;
+  std::atomic<uint64_t> messages_;
+  std::atomic<uint64_t> bytes_;
+  LogSiteStats* next_;
+};
+
+inline bool IsLogSiteAccountingEnabled() {
+  return g_log_site_accounting.load(std::memory_order_relaxed);
 }
 
+}  // namespace internal
+
 #if BUILDFLAG(IS_WIN)
 // This is just ::GetLastError, but out-of-line to avoid including windows.h in
 // such a widely used place.
@@ -92,6 +346,47 @@ static inline int GetLastSystemErrorCode() {
 }
 #endif
 
+namespace internal {
+
+// The std::streambuf behind LogMessage::stream(). Messages are formatted into
+// an inline buffer, so that typical messages are built without any heap
+// allocation. A message that outgrows the inline buffer spills into a
+// heap-allocated buffer that grows geometrically.
+class LogStreamBuf final : public std::streambuf {
+ public:
+  LogStreamBuf();
+
+  LogStreamBuf(const LogStreamBuf&) = delete;
+  LogStreamBuf& operator=(const LogStreamBuf&) = delete;
+
+  ~LogStreamBuf() override;
+
+  // The number of characters written so far.
+  size_t size() const { return static_cast<size_t>(pptr() - pbase()); }
+
+  // Returns the characters written so far. The view remains valid until the
+  // next write, and is followed in memory by a NUL terminator so that its
+  // data() may be passed to interfaces expecting a C string.
+  std::string_view str();
+
+ protected:
+  int_type overflow(int_type ch) override;
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+ private:
+  // Ensures that at least |additional| characters can be written, moving the
+  // buffer to |spill_| if necessary.
+  void Reserve(size_t additional);
+
+  // Advances the put pointer by |count| characters.
+  void Advance(size_t count);
+
+  char inline_buffer_[512];
+  std::string spill_;
+};
+
+}  // namespace internal
+
 class LogMessage {
  public:
   LogMessage(const char* function,
@@ -116,7 +411,9 @@ class LogMessage {
  private:
   void Init(const char* function);
 
-  std::ostringstream stream_;
+  internal::LogStreamBuf buffer_;
+  std::ostream stream_;
+  internal::LogSiteStats* const site_stats_;
   const char* file_path_;
   size_t message_start_;
   const int line_;
@@ -184,6 +481,89 @@ class ErrnoLogMessageFatal final : public ErrnoLogMessage {
 };
 #endif
 
+namespace internal {
+
+// Per-callsite state for LOG_EVERY_N() and PLOG_EVERY_N().
+class LogEveryNState {
+ public:
+  constexpr LogEveryNState() : count_(0) {}
+
+  LogEveryNState(const LogEveryNState&) = delete;
+  LogEveryNState& operator=(const LogEveryNState&) = delete;
+
+  // Returns true for the first of every |n| calls, storing the number of calls
+  // skipped since the previous true result in |suppressed|.
+  bool ShouldLog(uint64_t n, uint64_t* suppressed) {
+    const uint64_t count = count_.fetch_add(1, std::memory_order_relaxed);
+    if (n > 1 && count % n != 0) {
+      return false;
+    }
+    *suppressed = count == 0 || n <= 1 ? 0 : n - 1;
+    return true;
+  }
+
+ private:
+  std::atomic<uint64_t> count_;
+};
+
+// Per-callsite state for LOG_FIRST_N() and PLOG_FIRST_N().
+class LogFirstNState {
+ public:
+  constexpr LogFirstNState() : count_(0) {}
+
+  LogFirstNState(const LogFirstNState&) = delete;
+  LogFirstNState& operator=(const LogFirstNState&) = delete;
+
+  // Returns true for the first |n| calls. Nothing is logged after that, so
+  // |suppressed| is always 0.
+  bool ShouldLog(uint64_t n, uint64_t* suppressed) {
+    // Check before incrementing so that the count cannot wrap around.
+    if (count_.load(std::memory_order_relaxed) >= n ||
+        count_.fetch_add(1, std::memory_order_relaxed) >= n) {
+      return false;
+    }
+    *suppressed = 0;
+    return true;
+  }
+
+ private:
+  std::atomic<uint64_t> count_;
+};
+
+// Per-callsite state for LOG_EVERY_N_SEC() and PLOG_EVERY_N_SEC().
+class LogEveryNSecState {
+ public:
+  constexpr LogEveryNSecState() : next_log_time_(0), suppressed_(0) {}
+
+  LogEveryNSecState(const LogEveryNSecState&) = delete;
+  LogEveryNSecState& operator=(const LogEveryNSecState&) = delete;
+
+  // Returns true if at least |seconds| have passed on a monotonic clock since
+  // the previous true result, storing the number of calls skipped in the
+  // meantime in |suppressed|. When several threads race, only one of them
+  // logs.
+  bool ShouldLog(double seconds, uint64_t* suppressed);
+
+ private:
+  // In nanoseconds on the clock used by ShouldLog().
+  std::atomic<int64_t> next_log_time_;
+  std::atomic<uint64_t> suppressed_;
+};
+
+// Prefixes a rate-limited message with the number of messages suppressed at
+// its callsite since the previous one was logged.
+inline std::ostream& AppendSuppressedNote(std::ostream& stream,
+                                          uint64_t suppressed) {
+  if (suppressed != 0) [[unlikely]] {
+    stream << "[" << suppressed
+           << (suppressed == 1 ? " message suppressed] "
+                               : " messages suppressed] ");
+  }
+  return stream;
+}
+
+}  // namespace internal
+
 }  // namespace logging
 
 #if defined(COMPILER_MSVC)
@@ -192,26 +572,64 @@ class ErrnoLogMessageFatal final : public ErrnoLogMessage {
 #define FUNCTION_SIGNATURE __PRETTY_FUNCTION__
 #endif
 
+namespace logging {
+namespace internal {
+
+// Returns the part of |path| after its last path separator.
+consteval const char* FileNameFromPath(const char* path) {
+  const char* file_name = path;
+  for (const char* c = path; *c; ++c) {
+#if BUILDFLAG(IS_WIN)
+    if (*c == '/' || *c == '\\') {
+#else
+    if (*c == '/') {
+#endif
+      file_name = c + 1;
+    }
+  }
+  return file_name;
+}
+
+}  // namespace internal
+}  // namespace logging
+
+// The base name of the current source file, computed at compile time. Where the
+// compiler provides __FILE_NAME__, the full path of the file isn’t stored in
+// the binary at all.
+#if defined(__FILE_NAME__)
+#define LOG_FILE_NAME __FILE_NAME__
+#else
+#define LOG_FILE_NAME ::logging::internal::FileNameFromPath(__FILE__)
+#endif
+
+// LOG() statements below BUILDFLAG(MIN_LOG_SEVERITY), and VLOG(n) statements
+// when -n is below it, are compiled out, leaving no code or strings behind.
+// LOG(FATAL) is never compiled out. The minimum log level set at runtime
+// applies in addition to this.
+#define LOG_SEVERITY_IS_COMPILED_IN(severity) \
+  ((severity) >= BUILDFLAG(MIN_LOG_SEVERITY) || \
+   (severity) == ::logging::LOG_FATAL)
+
 #define COMPACT_GOOGLE_LOG_EX_INFO(ClassName, ...) \
-    logging::ClassName(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
+    logging::ClassName(FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, \
                        logging::LOG_INFO, ## __VA_ARGS__)
 #define COMPACT_GOOGLE_LOG_EX_WARNING(ClassName, ...) \
-    logging::ClassName(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
+    logging::ClassName(FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, \
                        logging::LOG_WARNING, ## __VA_ARGS__)
 #define COMPACT_GOOGLE_LOG_EX_ERROR(ClassName, ...) \
-    logging::ClassName(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
+    logging::ClassName(FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, \
                        logging::LOG_ERROR, ## __VA_ARGS__)
 #define COMPACT_GOOGLE_LOG_EX_ERROR_REPORT(ClassName, ...) \
-    logging::ClassName(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
+    logging::ClassName(FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, \
                        logging::LOG_ERROR_REPORT, ## __VA_ARGS__)
 #define COMPACT_GOOGLE_LOG_EX_FATAL(ClassName, ...) \
   logging::ClassName##Fatal(FUNCTION_SIGNATURE,     \
-                            __FILE__,               \
+                            LOG_FILE_NAME,          \
                             __LINE__,               \
                             logging::LOG_FATAL,     \
                             ##__VA_ARGS__)
 #define COMPACT_GOOGLE_LOG_EX_DFATAL(ClassName, ...) \
-    logging::ClassName(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
+    logging::ClassName(FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, \
                        logging::LOG_DFATAL, ## __VA_ARGS__)
 
 #define COMPACT_GOOGLE_LOG_INFO \
@@ -259,31 +677,73 @@ const LogSeverity LOG_0 = LOG_ERROR;
 
 // FATAL is always enabled and required to be resolved in compile time for
 // LOG(FATAL) to be properly understood as [[noreturn]].
-#define LOG_IS_ON(severity)                               \
-  ((::logging::LOG_##severity) == ::logging::LOG_FATAL || \
-   (::logging::LOG_##severity) >= ::logging::GetMinLogLevel())
-#define VLOG_IS_ON(verbose_level) \
-    ((verbose_level) <= ::logging::GetVlogLevel(__FILE__))
-
-#define LOG_STREAM(severity) COMPACT_GOOGLE_LOG_ ## severity.stream()
-#define VLOG_STREAM(verbose_level) \
-    logging::LogMessage(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
-                        -verbose_level).stream()
+#define LOG_IS_ON(severity)                                             \
+  (LOG_SEVERITY_IS_COMPILED_IN(::logging::LOG_##severity) &&            \
+   ((::logging::LOG_##severity) == ::logging::LOG_FATAL ||              \
+    (::logging::LOG_##severity) >=                                      \
+        ::logging::internal::GetMinCaptureLevel()))
+#define VLOG_IS_ON(verbose_level)                                \
+  (LOG_SEVERITY_IS_COMPILED_IN(-(verbose_level)) &&              \
+   (verbose_level) <= [] {                                       \
+     static ::logging::internal::VlogSite vlog_is_on_site;       \
+     return vlog_is_on_site.Level(__FILE__);                     \
+   }())
+
+// Counts a message in the statement’s LogSiteStats when log volume accounting
+// is enabled. Evaluated just before the statement’s LogMessage is constructed.
+#define LOG_SITE_MARK(severity)                                    \
+  (::logging::internal::IsLogSiteAccountingEnabled()               \
+       ? [](::logging::LogSeverity log_site_severity) {            \
+           static ::logging::internal::LogSiteStats log_site_stats( \
+               LOG_FILE_NAME, __LINE__);                           \
+           log_site_stats.Mark(log_site_severity);                 \
+         }(severity)                                               \
+       : void())
+
+// Like LOG_SITE_MARK(), but for the PLOG() family: evaluates to |error|, which
+// is read before the statement is counted, since counting may log the volumes
+// and so change the last system error.
+#define LOG_SITE_MARK_WITH_ERROR(severity, error)                          \
+  [](::logging::LogSeverity log_site_mark_severity, auto log_site_error) { \
+    LOG_SITE_MARK(log_site_mark_severity);                                 \
+    return log_site_error;                                                 \
+}((severity), (error))
+
+#define LOG_STREAM(severity)                   \
+  (LOG_SITE_MARK(::logging::LOG_##severity), \
+   COMPACT_GOOGLE_LOG_##severity.stream())
+#define VLOG_STREAM(verbose_level)                                   \
+  (LOG_SITE_MARK(-(verbose_level)),                                  \
+   logging::LogMessage(FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, \
+                       -verbose_level)                               \
+       .stream())
 
 #if BUILDFLAG(IS_WIN)
-#define PLOG_STREAM(severity) COMPACT_GOOGLE_LOG_EX_ ## severity( \
-    Win32ErrorLogMessage, ::logging::GetLastSystemErrorCode()).stream()
-#define VPLOG_STREAM(verbose_level)                                       \
-    logging::Win32ErrorLogMessage(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
-                                  -verbose_level,                         \
-                                  ::logging::GetLastSystemErrorCode()).stream()
+#define PLOG_STREAM(severity)                                        \
+  COMPACT_GOOGLE_LOG_EX_##severity(                                  \
+      Win32ErrorLogMessage,                                          \
+      LOG_SITE_MARK_WITH_ERROR(::logging::LOG_##severity,            \
+                               ::logging::GetLastSystemErrorCode())) \
+      .stream()
+#define VPLOG_STREAM(verbose_level)                                  \
+  logging::Win32ErrorLogMessage(                                     \
+      FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, -verbose_level,   \
+      LOG_SITE_MARK_WITH_ERROR(-(verbose_level),                     \
+                               ::logging::GetLastSystemErrorCode())) \
+      .stream()
 #elif BUILDFLAG(IS_POSIX)
-#define PLOG_STREAM(severity) COMPACT_GOOGLE_LOG_EX_ ## severity( \
-    ErrnoLogMessage, ::logging::GetLastSystemErrorCode()).stream()
-#define VPLOG_STREAM(verbose_level) \
-    logging::ErrnoLogMessage(FUNCTION_SIGNATURE, __FILE__, __LINE__, \
-                             -verbose_level, \
-                             ::logging::GetLastSystemErrorCode()).stream()
+#define PLOG_STREAM(severity)                                        \
+  COMPACT_GOOGLE_LOG_EX_##severity(                                  \
+      ErrnoLogMessage,                                               \
+      LOG_SITE_MARK_WITH_ERROR(::logging::LOG_##severity,            \
+                               ::logging::GetLastSystemErrorCode())) \
+      .stream()
+#define VPLOG_STREAM(verbose_level)                                  \
+  logging::ErrnoLogMessage(                                          \
+      FUNCTION_SIGNATURE, LOG_FILE_NAME, __LINE__, -verbose_level,   \
+      LOG_SITE_MARK_WITH_ERROR(-(verbose_level),                     \
+                               ::logging::GetLastSystemErrorCode())) \
+      .stream()
 #endif
 
 #define LOG(severity) LAZY_STREAM(LOG_STREAM(severity), LOG_IS_ON(severity))
@@ -308,6 +768,44 @@ const LogSeverity LOG_0 = LOG_ERROR;
     LAZY_STREAM(VPLOG_STREAM(verbose_level), \
                 VLOG_IS_ON(verbose_level) && (condition))
 
+// Rate-limited logging. Each callsite keeps its own lock-free state, and the
+// message is neither formatted nor constructed when the callsite is throttled.
+// A message that is logged after others were throttled is prefixed with the
+// number that were suppressed.
+//
+//   LOG_EVERY_N(ERROR, 100) << "Logged on calls 1, 101, 201, ...";
+//   LOG_FIRST_N(WARNING, 5) << "Logged on the first 5 calls only";
+//   LOG_EVERY_N_SEC(INFO, 0.5) << "Logged at most twice a second";
+#define LOG_THROTTLED_STREAM_(stream, severity, state_type, limit)    \
+  switch (0)                                                         \
+  case 0:                                                            \
+  default:                                                           \
+    if (uint64_t log_suppressed_count = 0;                           \
+        !LOG_IS_ON(severity) ||                                      \
+        ![]() -> ::logging::internal::state_type& {                  \
+          static ::logging::internal::state_type log_throttle_state; \
+          return log_throttle_state;                                 \
+        }()                                                          \
+                  .ShouldLog((limit), &log_suppressed_count))        \
+      ;                                                              \
+    else                                                             \
+      ::logging::internal::AppendSuppressedNote(stream(severity),    \
+                                                log_suppressed_count)
+
+#define LOG_EVERY_N(severity, n) \
+  LOG_THROTTLED_STREAM_(LOG_STREAM, severity, LogEveryNState, n)
+#define LOG_FIRST_N(severity, n) \
+  LOG_THROTTLED_STREAM_(LOG_STREAM, severity, LogFirstNState, n)
+#define LOG_EVERY_N_SEC(severity, seconds) \
+  LOG_THROTTLED_STREAM_(LOG_STREAM, severity, LogEveryNSecState, seconds)
+
+#define PLOG_EVERY_N(severity, n) \
+  LOG_THROTTLED_STREAM_(PLOG_STREAM, severity, LogEveryNState, n)
+#define PLOG_FIRST_N(severity, n) \
+  LOG_THROTTLED_STREAM_(PLOG_STREAM, severity, LogFirstNState, n)
+#define PLOG_EVERY_N_SEC(severity, seconds) \
+  LOG_THROTTLED_STREAM_(PLOG_STREAM, severity, LogEveryNSecState, seconds)
+
 #if defined(NDEBUG)
 #define DLOG_IS_ON(severity) 0
 #define DVLOG_IS_ON(verbose_level) 0
@@ -0,0 +1,293 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/logging.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/check.h"
+#include "testing/perf/perf_test.h"
+
+namespace logging {
+namespace {
+
+constexpr size_t kThreadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+
+// The messages logged in each throughput measurement, divided among its
+// threads.
+constexpr size_t kThroughputMessages = 128 * 1024;
+
+// The LOG() calls that each thread times individually when measuring latency.
+constexpr size_t kLatencyMessagesPerThread = 2048;
+
+enum class Destination {
+  kNullHandler,
+  kNullSink,
+  kStderr,
+  kStderrAsynchronous,
+  kFile,
+};
+
+constexpr Destination kDestinations[] = {
+    Destination::kNullHandler,
+    Destination::kNullSink,
+    Destination::kStderr,
+    Destination::kStderrAsynchronous,
+    Destination::kFile,
+};
+
+const char* DestinationName(Destination destination) {
+  switch (destination) {
+    case Destination::kNullHandler:
+      return "null_handler";
+    case Destination::kNullSink:
+      return "null_sink";
+    case Destination::kStderr:
+      return "stderr";
+    case Destination::kStderrAsynchronous:
+      return "stderr_async";
+    case Destination::kFile:
+      return "file";
+  }
+  return nullptr;
+}
+
+bool DiscardLogMessage(LogSeverity severity,
+                       const char* file_path,
+                       int line,
+                       size_t message_start,
+                       const std::string& string) {
+  return true;
+}
+
+class NullLogSink final : public LogSink {
+ public:
+  void Send(LogSeverity severity,
+            const char* file_path,
+            int line,
+            size_t message_start,
+            std::string_view message) override {}
+};
+
+// Points stderr at /dev/null, so that the stderr destinations measure the cost
+// of write() rather than that of a terminal.
+class ScopedStderrToDevNull {
+ public:
+  ScopedStderrToDevNull() : saved_stderr_(dup(STDERR_FILENO)) {
+    PCHECK(saved_stderr_ >= 0) << "dup";
+    const int dev_null = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    PCHECK(dev_null >= 0) << "open";
+    PCHECK(dup2(dev_null, STDERR_FILENO) == STDERR_FILENO) << "dup2";
+    close(dev_null);
+  }
+
+  ScopedStderrToDevNull(const ScopedStderrToDevNull&) = delete;
+  ScopedStderrToDevNull& operator=(const ScopedStderrToDevNull&) = delete;
+
+  ~ScopedStderrToDevNull() {
+    dup2(saved_stderr_, STDERR_FILENO);
+    close(saved_stderr_);
+  }
+
+ private:
+  const int saved_stderr_;
+};
+
+// Sends LOG() messages to |destination| alone for as long as it exists, and
+// then restores the default destination.
+class ScopedLogDestination {
+ public:
+  explicit ScopedLogDestination(Destination destination) {
+    LoggingSettings settings;
+    settings.logging_dest = LOG_NONE;
+    switch (destination) {
+      case Destination::kNullHandler:
+        SetLogMessageHandler(&DiscardLogMessage);
+        break;
+      case Destination::kNullSink:
+        AddLogSink(&null_sink_, LOG_VERBOSE);
+        break;
+      case Destination::kStderrAsynchronous:
+        settings.write_mode = LogWriteMode::kAsynchronous;
+        [[fallthrough]];
+      case Destination::kStderr:
+        settings.logging_dest = LOG_TO_STDERR;
+        stderr_to_dev_null_.emplace();
+        break;
+      case Destination::kFile: {
+        const char* const tmpdir = getenv("TMPDIR");
+        file_path_ = std::string(tmpdir && *tmpdir ? tmpdir : "/tmp") +
+                     "/base_perftests." + std::to_string(getpid()) + ".log";
+        settings.logging_dest = LOG_TO_FILE;
+        settings.log_file_path = file_path_.c_str();
+        break;
+      }
+    }
+    CHECK(InitLogging(settings));
+  }
+
+  ScopedLogDestination(const ScopedLogDestination&) = delete;
+  ScopedLogDestination& operator=(const ScopedLogDestination&) = delete;
+
+  ~ScopedLogDestination() {
+    // This drains the asynchronous writer and closes the log file before
+    // stderr is restored and the file removed.
+    CHECK(InitLogging(LoggingSettings()));
+    SetLogMessageHandler(nullptr);
+    RemoveLogSink(&null_sink_);
+    if (!file_path_.empty()) {
+      unlink(file_path_.c_str());
+    }
+  }
+
+ private:
+  NullLogSink null_sink_;
+  std::optional<ScopedStderrToDevNull> stderr_to_dev_null_;
+  std::string file_path_;
+};
+
+// A message typical of those logged in production, with a few insertions.
+void LogTypicalMessage(size_t thread, size_t index) {
+  LOG(INFO) << "perftest message " << index << " from thread " << thread
+            << ", ratio " << 0.5;
+}
+
+// Calls |body(thread)| on |thread_count| threads that start at once, and
+// returns the time from their start until the last one finishes.
+template <typename Body>
+int64_t RunOnThreads(size_t thread_count, Body body) {
+  std::atomic<size_t> ready(0);
+  std::atomic<bool> start(false);
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+  for (size_t thread = 0; thread < thread_count; ++thread) {
+    threads.emplace_back([&, thread] {
+      ready.fetch_add(1, std::memory_order_relaxed);
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      body(thread);
+    });
+  }
+  while (ready.load(std::memory_order_relaxed) != thread_count) {
+    std::this_thread::yield();
+  }
+  const int64_t start_time = perf_test::NowNanoseconds();
+  start.store(true, std::memory_order_release);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  return perf_test::NowNanoseconds() - start_time;
+}
+
+std::string Story(Destination destination, size_t thread_count) {
+  return std::string(DestinationName(destination)) + "_" +
+         std::to_string(thread_count) + "_threads";
+}
+
+double Percentile(const std::vector<int64_t>& sorted, double percentile) {
+  const size_t index = static_cast<size_t>(
+      percentile / 100 * static_cast<double>(sorted.size() - 1));
+  return static_cast<double>(sorted[index]);
+}
+
+}  // namespace
+
+PERF_TEST(Logging, Throughput) {
+  for (const Destination destination : kDestinations) {
+    ScopedLogDestination scoped_destination(destination);
+    for (const size_t thread_count : kThreadCounts) {
+      const size_t messages_per_thread = kThroughputMessages / thread_count;
+      const int64_t elapsed = RunOnThreads(thread_count, [&](size_t thread) {
+        for (size_t index = 0; index < messages_per_thread; ++index) {
+          LogTypicalMessage(thread, index);
+        }
+      });
+      perf_test::PrintResult(
+          "log_throughput",
+          Story(destination, thread_count),
+          static_cast<double>(messages_per_thread * thread_count) * 1e9 /
+              static_cast<double>(elapsed),
+          "messages_per_s");
+    }
+  }
+}
+
+PERF_TEST(Logging, Latency) {
+  for (const Destination destination : kDestinations) {
+    ScopedLogDestination scoped_destination(destination);
+    for (const size_t thread_count : kThreadCounts) {
+      std::vector<int64_t> latencies(thread_count * kLatencyMessagesPerThread);
+      RunOnThreads(thread_count, [&](size_t thread) {
+        int64_t* const thread_latencies =
+            &latencies[thread * kLatencyMessagesPerThread];
+        for (size_t index = 0; index < kLatencyMessagesPerThread; ++index) {
+          const int64_t start = perf_test::NowNanoseconds();
+          LogTypicalMessage(thread, index);
+          thread_latencies[index] = perf_test::NowNanoseconds() - start;
+        }
+      });
+      std::sort(latencies.begin(), latencies.end());
+      const std::string story = Story(destination, thread_count);
+      perf_test::PrintResult(
+          "log_latency_p50", story, Percentile(latencies, 50), "ns");
+      perf_test::PrintResult(
+          "log_latency_p99", story, Percentile(latencies, 99), "ns");
+      perf_test::PrintResult(
+          "log_latency_p99.9", story, Percentile(latencies, 99.9), "ns");
+      perf_test::PrintResult("log_latency_max",
+                             story,
+                             static_cast<double>(latencies.back()),
+                             "ns");
+    }
+  }
+}
+
+// Messages that fit in LogMessage’s inline buffer should not allocate on the
+// way to a sink.
+PERF_TEST(Logging, Allocations) {
+  constexpr size_t kMessages = 10000;
+  const std::string long_text(4096, 'x');
+  for (const Destination destination :
+       {Destination::kNullHandler, Destination::kNullSink}) {
+    ScopedLogDestination scoped_destination(destination);
+    for (size_t index = 0; index < 100; ++index) {
+      LogTypicalMessage(0, index);
+    }
+
+    uint64_t allocations = perf_test::ThreadAllocationCount();
+    for (size_t index = 0; index < kMessages; ++index) {
+      LogTypicalMessage(0, index);
+    }
+    allocations = perf_test::ThreadAllocationCount() - allocations;
+    perf_test::PrintResult(
+        "log_allocations",
+        std::string(DestinationName(destination)) + "_typical",
+        static_cast<double>(allocations) / kMessages,
+        "allocations_per_message");
+
+    allocations = perf_test::ThreadAllocationCount();
+    for (size_t index = 0; index < kMessages; ++index) {
+      LOG(INFO) << long_text;
+    }
+    allocations = perf_test::ThreadAllocationCount() - allocations;
+    perf_test::PrintResult(
+        "log_allocations",
+        std::string(DestinationName(destination)) + "_long",
+        static_cast<double>(allocations) / kMessages,
+        "allocations_per_message");
+  }
+}
+
+}  // namespace logging
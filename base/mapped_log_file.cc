@@ -0,0 +1,364 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/mapped_log_file.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+#include "base/posix/eintr_wrapper.h"
+#include "build/build_config.h"
+
+namespace logging {
+namespace internal {
+
+namespace {
+
+// The size of each mapped region. This is a multiple of every supported page
+// size.
+constexpr off_t kRegionSize = 1024 * 1024;
+
+// Returns the length of the data in |fd|, which is |size| bytes long, excluding
+// zero bytes left at the end of a preallocated region by a process that didn’t
+// close the file. Only the last region’s worth of the file is examined.
+off_t FindEndOfData(int fd, off_t size) {
+  char buffer[4096];
+  const off_t limit = size > kRegionSize ? size - kRegionSize : 0;
+  off_t end = size;
+  while (end > limit) {
+    const size_t count = static_cast<size_t>(
+        std::min(end - limit, static_cast<off_t>(sizeof(buffer))));
+    const off_t start = end - static_cast<off_t>(count);
+    if (HANDLE_EINTR(pread(fd, buffer, count, start)) !=
+        static_cast<ssize_t>(count)) {
+      return end;
+    }
+    for (size_t index = count; index > 0; --index) {
+      if (buffer[index - 1] != '\0') {
+        return start + static_cast<off_t>(index);
+      }
+    }
+    end = start;
+  }
+  return end;
+}
+
+// Extends |fd| from |size| to |new_size| bytes. Where possible, disk space is
+// allocated now, so that running out of space is detected here rather than by
+// SIGBUS when a page of the mapping is first written back.
+bool Preallocate(int fd, off_t size, off_t new_size) {
+#if !BUILDFLAG(IS_APPLE)
+  int rv;
+  do {
+    rv = posix_fallocate(fd, size, new_size - size);
+  } while (rv == EINTR);
+  if (rv == 0) {
+    return true;
+  }
+  if (rv != EINVAL && rv != EOPNOTSUPP && rv != ENOSYS) {
+    return false;
+  }
+  // The file system doesn’t support allocation, so fall back to extending the
+  // file sparsely.
+#endif  // !BUILDFLAG(IS_APPLE)
+  return HANDLE_EINTR(ftruncate(fd, new_size)) == 0;
+}
+
+}  // namespace
+
+MappedLogFile::MappedLogFile(const base::FilePath& path,
+                             size_t max_file_size,
+                             size_t max_file_count)
+    : path_(path),
+      max_file_size_(max_file_size),
+      max_file_count_(max_file_count),
+      lock_(),
+      fd_(),
+      mapped_(false),
+      region_(nullptr),
+      region_offset_(0),
+      length_(0),
+      file_size_(0) {}
+
+MappedLogFile::~MappedLogFile() {
+  Close();
+}
+
+bool MappedLogFile::Open() {
+  base::AutoLock lock(lock_);
+  return OpenLocked(false);
+}
+
+void MappedLogFile::Close() {
+  base::AutoLock lock(lock_);
+  CloseLocked();
+}
+
+void MappedLogFile::Write(std::string_view message) {
+  base::AutoLock lock(lock_);
+  if (!fd_.is_valid()) {
+    return;
+  }
+
+  if (max_file_size_ != 0 && length_ != 0 &&
+      static_cast<size_t>(length_) + message.size() > max_file_size_) {
+    if (mapped_) {
+      RotateLocked();
+    } else {
+      // Rotating is left to the writer holding the lock, which has likely
+      // done so already.
+      CloseLocked();
+      OpenLocked(false);
+    }
+    if (!fd_.is_valid()) {
+      return;
+    }
+  }
+
+  // Make room for the whole message before copying any of it, so that if
+  // another writer has appended to the file, the message is appended after it
+  // in one piece.
+  const off_t message_end = length_ + static_cast<off_t>(message.size());
+  if (mapped_ && message_end > file_size_ &&
+      !ExtendLocked(message_end + (kRegionSize - message_end % kRegionSize) %
+                                      kRegionSize)) {
+    CloseLocked();
+    return;
+  }
+  if (!mapped_) {
+    AppendLocked(message);
+    return;
+  }
+
+  while (!message.empty()) {
+    if (!region_ || length_ >= region_offset_ + kRegionSize) {
+      if (!MapRegionLocked(length_)) {
+        CloseLocked();
+        return;
+      }
+    }
+
+    const size_t count =
+        std::min(static_cast<size_t>(region_offset_ + kRegionSize - length_),
+                 message.size());
+    memcpy(region_ + (length_ - region_offset_), message.data(), count);
+    length_ += static_cast<off_t>(count);
+    message.remove_prefix(count);
+  }
+}
+
+void MappedLogFile::AtForkPrepare() {
+  lock_.Acquire();
+}
+
+void MappedLogFile::AtForkParent() {
+  lock_.Release();
+}
+
+MappedLogFile* MappedLogFile::AtForkChild() {
+  // The mapping is shared with the parent, which goes on writing to it. The
+  // lock on the file belongs to the parent’s open file description, so closing
+  // the child’s descriptor for it leaves the parent holding the lock.
+  if (region_) {
+    munmap(region_, kRegionSize);
+    region_ = nullptr;
+  }
+  if (!fd_.is_valid()) {
+    return nullptr;
+  }
+  fd_.reset();
+
+  MappedLogFile* log_file =
+      new MappedLogFile(path_, max_file_size_, max_file_count_);
+  if (!log_file->Open()) {
+    delete log_file;
+    return nullptr;
+  }
+  return log_file;
+}
+
+bool MappedLogFile::OpenLocked(bool truncate) {
+  lock_.AssertAcquired();
+
+  fd_.reset(HANDLE_EINTR(
+      open(path_.value().c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)));
+  if (!fd_.is_valid()) {
+    return false;
+  }
+
+  // Another writer may hold the lock, or the file system may not support it.
+  // Either way, the file can’t be mapped, and can only be appended to.
+  if (flock(fd_.get(), LOCK_EX | LOCK_NB) != 0) {
+    if (!StopMappingLocked()) {
+      fd_.reset();
+      return false;
+    }
+    length_ = 0;
+    file_size_ = 0;
+    return true;
+  }
+  mapped_ = true;
+
+  // Truncate only once the lock is held, since another writer may have the
+  // file mapped until then.
+  if (truncate && HANDLE_EINTR(ftruncate(fd_.get(), 0)) != 0) {
+    fd_.reset();
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd_.get(), &st) != 0) {
+    fd_.reset();
+    return false;
+  }
+
+  length_ = FindEndOfData(fd_.get(), st.st_size);
+  if (length_ != st.st_size &&
+      HANDLE_EINTR(ftruncate(fd_.get(), length_)) != 0) {
+    fd_.reset();
+    return false;
+  }
+  file_size_ = length_;
+  return true;
+}
+
+void MappedLogFile::CloseLocked() {
+  lock_.AssertAcquired();
+
+  if (!fd_.is_valid()) {
+    return;
+  }
+
+  UnmapRegionLocked();
+
+  // Remove the preallocated tail, unless another writer has appended to the
+  // file after it. If this fails, it will be removed when the file is next
+  // opened.
+  struct stat st;
+  if (mapped_ && file_size_ != length_ && fstat(fd_.get(), &st) == 0 &&
+      st.st_size == file_size_) {
+    HANDLE_EINTR(ftruncate(fd_.get(), length_));
+  }
+  fd_.reset();
+}
+
+void MappedLogFile::RotateLocked() {
+  lock_.AssertAcquired();
+
+  CloseLocked();
+  for (size_t index = max_file_count_ > 0 ? max_file_count_ - 1 : 0;
+       index > 0;
+       --index) {
+    // The source doesn’t exist until enough rotations have happened, and the
+    // destination, if it exists, is the oldest file and is replaced.
+    rename(RotatedPath(index - 1).value().c_str(),
+           RotatedPath(index).value().c_str());
+  }
+  OpenLocked(true);
+}
+
+bool MappedLogFile::ExtendLocked(off_t size) {
+  lock_.AssertAcquired();
+
+  // Another writer appends at the end of the file, which is where the new part
+  // of the file begins. Anything that it appended before the file was extended
+  // is found there afterwards.
+  struct stat st;
+  if (fstat(fd_.get(), &st) != 0) {
+    return false;
+  }
+  if (st.st_size != file_size_) {
+    return StopMappingLocked();
+  }
+  if (!Preallocate(fd_.get(), file_size_, size)) {
+    return false;
+  }
+  char byte;
+  if (HANDLE_EINTR(pread(fd_.get(), &byte, 1, file_size_)) != 1) {
+    return false;
+  }
+  file_size_ = size;
+  if (byte != '\0') {
+    return StopMappingLocked();
+  }
+  return true;
+}
+
+bool MappedLogFile::MapRegionLocked(off_t offset) {
+  lock_.AssertAcquired();
+
+  UnmapRegionLocked();
+
+  const off_t region_offset = offset - offset % kRegionSize;
+  void* region = mmap(nullptr,
+                      kRegionSize,
+                      PROT_READ | PROT_WRITE,
+                      MAP_SHARED,
+                      fd_.get(),
+                      region_offset);
+  if (region == MAP_FAILED) {
+    return false;
+  }
+
+  region_ = static_cast<char*>(region);
+  region_offset_ = region_offset;
+  return true;
+}
+
+bool MappedLogFile::StopMappingLocked() {
+  lock_.AssertAcquired();
+
+  UnmapRegionLocked();
+  mapped_ = false;
+
+  // The file offset of |fd_| is never moved, so without O_APPEND, write() would
+  // overwrite the beginning of the file.
+  const int flags = fcntl(fd_.get(), F_GETFL);
+  return flags != -1 && fcntl(fd_.get(), F_SETFL, flags | O_APPEND) == 0;
+}
+
+void MappedLogFile::AppendLocked(std::string_view message) {
+  lock_.AssertAcquired();
+
+  while (!message.empty()) {
+    const ssize_t written =
+        HANDLE_EINTR(write(fd_.get(), message.data(), message.size()));
+    if (written <= 0) {
+      return;
+    }
+    length_ += written;
+    message.remove_prefix(static_cast<size_t>(written));
+  }
+}
+
+void MappedLogFile::UnmapRegionLocked() {
+  lock_.AssertAcquired();
+
+  if (!region_) {
+    return;
+  }
+
+  msync(region_, kRegionSize, MS_ASYNC);
+  munmap(region_, kRegionSize);
+  region_ = nullptr;
+}
+
+base::FilePath MappedLogFile::RotatedPath(size_t index) const {
+  if (index == 0) {
+    return path_;
+  }
+  return base::FilePath(path_.value() + "." + std::to_string(index));
+}
+
+}  // namespace internal
+}  // namespace logging
@@ -0,0 +1,138 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_MAPPED_LOG_FILE_H_
+#define MINI_CHROMIUM_BASE_MAPPED_LOG_FILE_H_
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#include <string_view>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_file.h"
+#include "base/synchronization/lock.h"
+
+namespace logging {
+namespace internal {
+
+// MappedLogFile implements LOG_TO_FILE. Rather than calling write() for each
+// message, it copies messages into a shared memory mapping of a region of the
+// file that has been preallocated ahead of the messages. A system call is only
+// needed each time a region fills up, at which point its dirty pages are
+// scheduled for writeback with msync(MS_ASYNC) and the next region is mapped.
+// Because the mapping is shared, messages reach the page cache as soon as they
+// are copied, and survive a crash of the process.
+//
+// The preallocated tail of the file is zero-filled. It is truncated away when
+// the file is closed or rotated, and, if the process crashed, when the file is
+// next opened.
+//
+// When |max_file_size| is nonzero and a message would grow the file beyond it,
+// the file is rotated: “log” is renamed to “log.1”, “log.1” to “log.2”, and so
+// on, keeping at most |max_file_count| files including the current one.
+//
+// Only one writer at a time may map a file: the one holding an exclusive
+// flock() on it, taken when the file is opened. Any other MappedLogFile for the
+// same file, whether in another process or in a child after fork(), appends
+// each message with write() instead, and reopens the file after appending
+// |max_file_size| bytes rather than rotating it. The writer holding the lock
+// also switches to write() once it sees that another has appended to the file,
+// leaving the unused part of its last region as NUL bytes. This is checked
+// each time a region is mapped and when the file is closed, so a message
+// appended by another process at the moment the lock holder maps a region or
+// truncates the file can still be overwritten or lost.
+//
+// A child process doesn’t write to the mapping that it inherits across fork().
+// It unmaps it and opens the file again, which it then shares with its parent
+// as above.
+//
+// The lock is advisory, so nothing stops a process that doesn’t use
+// MappedLogFile, such as a log rotation tool that truncates the file in place,
+// from shrinking the file under the mapping. Writing to a page of the mapping
+// beyond the new end of the file then raises SIGBUS, which kills the process
+// unless it handles the signal. The file must therefore only be rotated by
+// renaming it, as MappedLogFile does itself.
+class MappedLogFile {
+ public:
+  MappedLogFile(const base::FilePath& path,
+                size_t max_file_size,
+                size_t max_file_count);
+
+  MappedLogFile(const MappedLogFile&) = delete;
+  MappedLogFile& operator=(const MappedLogFile&) = delete;
+
+  ~MappedLogFile();
+
+  // Opens the file, appending to it if it already exists. Returns false on
+  // failure.
+  bool Open();
+
+  // Closes the file. Subsequent writes are discarded.
+  void Close();
+
+  // Appends |message| to the file. Errors are not reported, because there is
+  // nowhere to report them, but a failure to extend the file closes it.
+  void Write(std::string_view message);
+
+  // Hold |lock_| across fork(), so that the child gets a consistent copy of
+  // the object. AtForkChild() returns the object that replaces this one in the
+  // child, or nullptr if the file was closed or can’t be opened again. This
+  // object is abandoned, because the child can’t release |lock_|.
+  void AtForkPrepare();
+  void AtForkParent();
+  MappedLogFile* AtForkChild();
+
+ private:
+  bool OpenLocked(bool truncate);
+  void CloseLocked();
+  void RotateLocked();
+
+  // Preallocates the file up to |size| bytes, a multiple of the region size.
+  // Returns false on failure. If another writer has appended to the file,
+  // calls StopMappingLocked() instead.
+  bool ExtendLocked(off_t size);
+
+  // Maps the region of the file containing |offset|, which must already have
+  // been preallocated. Returns false on failure.
+  bool MapRegionLocked(off_t offset);
+  void UnmapRegionLocked();
+
+  // Switches from the mapping to appending with write(). Returns false on
+  // failure.
+  bool StopMappingLocked();
+
+  // Appends |message| with write(), for a writer that doesn’t hold the lock.
+  void AppendLocked(std::string_view message);
+
+  // Returns the path of the |index|th rotated file, or |path_| for 0.
+  base::FilePath RotatedPath(size_t index) const;
+
+  const base::FilePath path_;
+  const size_t max_file_size_;
+  const size_t max_file_count_;
+
+  base::Lock lock_;
+  base::ScopedFD fd_;
+
+  // Whether the file is written through the mapping, which requires holding
+  // the lock on it.
+  bool mapped_;
+
+  char* region_;
+  off_t region_offset_;
+
+  // The number of bytes of log data in the file, which is also the offset at
+  // which the next message will be written. When the file isn’t |mapped_|,
+  // only the bytes appended since it was opened are counted.
+  off_t length_;
+
+  // The size of the file including its preallocated tail.
+  off_t file_size_;
+};
+
+}  // namespace internal
+}  // namespace logging
+
+#endif  // MINI_CHROMIUM_BASE_MAPPED_LOG_FILE_H_
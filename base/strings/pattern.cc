@@ -4,9 +4,24 @@
 
 #include "base/strings/pattern.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <memory>
 #include <string_view>
+#include <utility>
 
+#include "base/check_op.h"
 #include "base/third_party/icu/icu_utf.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace base {
 
@@ -142,6 +157,89 @@ struct NextCharUTF16 {
   }
 };
 
+// Returns the first occurrence of |literal| in [begin, end), or nullptr. Each
+// vector holds the candidate positions whose first and last bytes both match,
+// so only those are compared in full.
+const char* FindLiteral(const char* begin,
+                        const char* end,
+                        std::string_view literal) {
+  const size_t size = literal.size();
+  if (size == 0) {
+    return begin;
+  }
+  if (static_cast<size_t>(end - begin) < size) {
+    return nullptr;
+  }
+  if (size == 1) {
+    return static_cast<const char*>(
+        memchr(begin, literal[0], static_cast<size_t>(end - begin)));
+  }
+
+  // The last position at which |literal| could start.
+  const char* const last = end - size;
+  const char* string = begin;
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+  const __m128i first_byte = _mm_set1_epi8(literal.front());
+  const __m128i last_byte = _mm_set1_epi8(literal.back());
+  for (; last - string >= 15; string += 16) {
+    const __m128i firsts =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(string));
+    const __m128i lasts =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(string + size - 1));
+    uint32_t candidates = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(firsts, first_byte),
+                      _mm_cmpeq_epi8(lasts, last_byte))));
+    for (; candidates != 0; candidates &= candidates - 1) {
+      const char* const candidate = string + std::countr_zero(candidates);
+      if (memcmp(candidate + 1, literal.data() + 1, size - 2) == 0) {
+        return candidate;
+      }
+    }
+  }
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+  const uint8x16_t first_byte =
+      vdupq_n_u8(static_cast<uint8_t>(literal.front()));
+  const uint8x16_t last_byte = vdupq_n_u8(static_cast<uint8_t>(literal.back()));
+  for (; last - string >= 15; string += 16) {
+    const uint8x16_t firsts =
+        vld1q_u8(reinterpret_cast<const uint8_t*>(string));
+    const uint8x16_t lasts =
+        vld1q_u8(reinterpret_cast<const uint8_t*>(string + size - 1));
+    const uint8x16_t matches =
+        vandq_u8(vceqq_u8(firsts, first_byte), vceqq_u8(lasts, last_byte));
+    // Narrows each byte of |matches| to four bits.
+    uint64_t candidates = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+    while (candidates != 0) {
+      const int bit = std::countr_zero(candidates);
+      const char* const candidate = string + bit / 4;
+      if (memcmp(candidate + 1, literal.data() + 1, size - 2) == 0) {
+        return candidate;
+      }
+      candidates &= ~(uint64_t{0xF} << bit);
+    }
+  }
+#endif
+  for (; string <= last; ++string) {
+    string = static_cast<const char*>(
+        memchr(string, literal[0], static_cast<size_t>(last - string) + 1));
+    if (!string) {
+      return nullptr;
+    }
+    if (memcmp(string + 1, literal.data() + 1, size - 1) == 0) {
+      return string;
+    }
+  }
+  return nullptr;
+}
+
+// Returns the start of the character after the one at |string|, as
+// NextCharUTF8 would.
+const char* SkipCharUTF8(const char* string, const char* end) {
+  NextCharUTF8()(&string, end);
+  return string;
+}
+
 }  // namespace
 
 bool MatchPattern(std::string_view eval, std::string_view pattern) {
@@ -154,4 +252,250 @@ bool MatchPattern(std::u16string_view eval, std::u16string_view pattern) {
                        pattern.data() + pattern.size(), NextCharUTF16());
 }
 
+CompiledPattern::CompiledPattern(std::string_view pattern) {
+  const char* const data = pattern.data();
+  const size_t length = pattern.size();
+  size_t i = 0;
+  do {
+    Segment segment = {0, literals_.size(), 0};
+    for (; i < length && IsWildcard(data[i]); ++i) {
+      if (data[i] == '*') {
+        segment.max_distance = -1;
+      } else if (segment.max_distance >= 0) {
+        ++segment.max_distance;
+      }
+    }
+
+    while (i < length && !IsWildcard(data[i])) {
+      if (data[i] == '\\' && ++i == length) {
+        unpaired_escape_pattern_.assign(pattern);
+        break;
+      }
+      // Characters are compared whole, so one that is not valid UTF-8 in the
+      // pattern never compares equal.
+      const size_t char_begin = i;
+      base_icu::UChar32 c;
+      CBU8_NEXT(reinterpret_cast<const uint8_t*>(data), i, length, c);
+      if (c == CBU_SENTINEL) {
+        never_matches_ = true;
+      }
+      literals_.append(data + char_begin, i - char_begin);
+    }
+    segment.size = literals_.size() - segment.begin;
+    segments_.push_back(segment);
+  } while (i < length);
+}
+
+CompiledPattern::CompiledPattern(const CompiledPattern&) = default;
+CompiledPattern::CompiledPattern(CompiledPattern&&) = default;
+CompiledPattern& CompiledPattern::operator=(const CompiledPattern&) = default;
+CompiledPattern& CompiledPattern::operator=(CompiledPattern&&) = default;
+
+CompiledPattern::~CompiledPattern() = default;
+
+bool CompiledPattern::Match(std::string_view string) const {
+  if (never_matches_) {
+    return false;
+  }
+  if (!unpaired_escape_pattern_.empty()) {
+    return MatchPattern(string, unpaired_escape_pattern_);
+  }
+
+  // A valid literal starts with a byte that begins a character wherever it
+  // occurs, and equal bytes decode to equal characters, so literals are
+  // compared and searched for byte by byte. Like MatchPattern(), this takes
+  // the first position at which each literal matches.
+  const char* s = string.data();
+  const char* const end = s + string.size();
+  const Segment* const last_segment = &segments_.back();
+  for (const Segment* segment = segments_.data(); segment <= last_segment;
+       ++segment) {
+    const std::string_view literal = Literal(*segment);
+    const bool is_last = segment == last_segment;
+    if (segment->max_distance < 0) {
+      if (is_last) {
+        return static_cast<size_t>(end - s) >= literal.size() &&
+               memcmp(end - literal.size(), literal.data(), literal.size()) ==
+                   0;
+      }
+      s = FindLiteral(s, end, literal);
+      if (!s) {
+        return false;
+      }
+      s += literal.size();
+      continue;
+    }
+
+    for (int distance = segment->max_distance;; --distance) {
+      const size_t remaining = static_cast<size_t>(end - s);
+      if (remaining >= literal.size() &&
+          (!is_last || remaining == literal.size()) &&
+          memcmp(s, literal.data(), literal.size()) == 0) {
+        s += literal.size();
+        break;
+      }
+      if (distance == 0 || s == end) {
+        return false;
+      }
+      s = SkipCharUTF8(s, end);
+    }
+  }
+  return true;
+}
+
+PatternSet::PatternSet(span<const std::string_view> patterns) {
+  CHECK_LE(patterns.size(), size_t{UINT32_MAX});
+  // Reserved up front, so that |literals| can point into |patterns_|.
+  patterns_.reserve(patterns.size());
+  std::vector<std::string_view> literals;
+  literals.reserve(patterns.size());
+  bool byte_used[256] = {};
+  for (size_t index = 0; index < patterns.size(); ++index) {
+    const CompiledPattern& pattern = patterns_.emplace_back(patterns[index]);
+
+    // Every string that matches contains each of the pattern’s literals, so
+    // the longest one is the most selective.
+    std::string_view longest;
+    for (const CompiledPattern::Segment& segment : pattern.segments_) {
+      if (segment.size > longest.size()) {
+        longest = pattern.Literal(segment);
+      }
+    }
+    literals.push_back(longest);
+    if (pattern.never_matches_) {
+      continue;
+    }
+    if (longest.empty() || !pattern.unpaired_escape_pattern_.empty()) {
+      unfiltered_.push_back(static_cast<uint32_t>(index));
+    }
+    for (const char c : longest) {
+      byte_used[static_cast<uint8_t>(c)] = true;
+    }
+  }
+
+  // Class 0 is left for the unused bytes, if there are any.
+  class_count_ = std::all_of(std::begin(byte_used), std::end(byte_used),
+                             [](bool used) { return used; })
+                     ? 0
+                     : 1;
+  for (size_t byte = 0; byte < 256; ++byte) {
+    byte_classes_[byte] =
+        byte_used[byte] ? static_cast<uint8_t>(class_count_++) : 0;
+  }
+
+  // Build the trie of literals, in which a transition to 0, the root, is
+  // missing, along with each state’s patterns.
+  constexpr uint32_t kRoot = 0;
+  std::vector<std::vector<uint32_t>> state_outputs(1);
+  transitions_.assign(class_count_, kRoot);
+  for (size_t index = 0; index < literals.size(); ++index) {
+    if (literals[index].empty() || patterns_[index].never_matches_ ||
+        !patterns_[index].unpaired_escape_pattern_.empty()) {
+      continue;
+    }
+    size_t state = kRoot;
+    for (const char c : literals[index]) {
+      const size_t transition = state + byte_classes_[static_cast<uint8_t>(c)];
+      if (transitions_[transition] == kRoot) {
+        transitions_[transition] = static_cast<uint32_t>(transitions_.size());
+        transitions_.resize(transitions_.size() + class_count_, kRoot);
+        state_outputs.emplace_back();
+      }
+      state = transitions_[transition];
+    }
+    state_outputs[state / class_count_].push_back(static_cast<uint32_t>(index));
+  }
+  CHECK_LT(transitions_.size(), size_t{kHasOutputs});
+
+  // Fill in the missing transitions breadth first, each from the state for
+  // the longest proper suffix that is also in the trie, whose patterns are
+  // matched too.
+  std::vector<uint32_t> suffix(state_outputs.size(), kRoot);
+  std::vector<uint32_t> queue;
+  for (size_t c = 0; c < class_count_; ++c) {
+    if (transitions_[c] != kRoot) {
+      queue.push_back(transitions_[c]);
+    }
+  }
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const uint32_t state = queue[head];
+    const uint32_t state_suffix = suffix[state / class_count_];
+    for (size_t c = 0; c < class_count_; ++c) {
+      uint32_t& next = transitions_[state + c];
+      if (next == kRoot) {
+        next = transitions_[state_suffix + c];
+        continue;
+      }
+      const uint32_t next_suffix = transitions_[state_suffix + c];
+      suffix[next / class_count_] = next_suffix;
+      const std::vector<uint32_t>& inherited =
+          state_outputs[next_suffix / class_count_];
+      std::vector<uint32_t>& outputs = state_outputs[next / class_count_];
+      outputs.insert(outputs.end(), inherited.begin(), inherited.end());
+      queue.push_back(next);
+    }
+  }
+
+  for (uint32_t& next : transitions_) {
+    if (!state_outputs[next / class_count_].empty()) {
+      next |= kHasOutputs;
+    }
+  }
+
+  output_begin_.reserve(state_outputs.size() + 1);
+  for (const std::vector<uint32_t>& outputs : state_outputs) {
+    output_begin_.push_back(static_cast<uint32_t>(outputs_.size()));
+    outputs_.insert(outputs_.end(), outputs.begin(), outputs.end());
+  }
+  output_begin_.push_back(static_cast<uint32_t>(outputs_.size()));
+}
+
+PatternSet::~PatternSet() = default;
+
+size_t PatternSet::FirstMatch(std::string_view string) const {
+  // One bit per pattern, set for each candidate.
+  const size_t word_count = (patterns_.size() + 63) / 64;
+  uint64_t stack_words[16];
+  std::unique_ptr<uint64_t[]> heap_words;
+  uint64_t* words = stack_words;
+  if (word_count > std::size(stack_words)) {
+    heap_words = std::make_unique<uint64_t[]>(word_count);
+    words = heap_words.get();
+  }
+  std::fill_n(words, word_count, 0);
+  for (const uint32_t index : unfiltered_) {
+    words[index / 64] |= uint64_t{1} << (index % 64);
+  }
+
+  const uint32_t* const transitions = transitions_.data();
+  const uint32_t* const output_begin = output_begin_.data();
+  const size_t class_count = class_count_;
+  uint32_t state = 0;
+  const char* const end = string.data() + string.size();
+  for (const char* s = string.data(); s != end; ++s) {
+    const uint32_t next =
+        transitions[state + byte_classes_[static_cast<uint8_t>(*s)]];
+    state = next & ~kHasOutputs;
+    if (next & kHasOutputs) [[unlikely]] {
+      const size_t state_index = state / class_count;
+      for (uint32_t output = output_begin[state_index];
+           output != output_begin[state_index + 1]; ++output) {
+        const uint32_t index = outputs_[output];
+        words[index / 64] |= uint64_t{1} << (index % 64);
+      }
+    }
+  }
+
+  for (size_t word = 0; word < word_count; ++word) {
+    for (uint64_t bits = words[word]; bits != 0; bits &= bits - 1) {
+      const size_t index =
+          word * 64 + static_cast<size_t>(std::countr_zero(bits));
+      if (patterns_[index].Match(string)) {
+        return index;
+      }
+    }
+  }
+  return kNoMatch;
+}
+
 }  // namespace base
@@ -5,7 +5,14 @@
 #ifndef BASE_STRINGS_PATTERN_H_
 #define BASE_STRINGS_PATTERN_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
 #include <string_view>
+#include <vector>
+
+#include "base/containers/span.h"
 
 namespace base {
 
@@ -17,6 +24,103 @@ namespace base {
 bool MatchPattern(std::string_view string, std::string_view pattern);
 bool MatchPattern(std::u16string_view string, std::u16string_view pattern);
 
+// A UTF-8 pattern for MatchPattern(), preprocessed to be matched against many
+// strings. The pattern is split once into runs of literal text, each preceded
+// by the wildcards before it, and the literal text after a * is found with a
+// vectorized substring search rather than character by character. Match()
+// returns exactly what MatchPattern() would.
+class CompiledPattern {
+ public:
+  explicit CompiledPattern(std::string_view pattern);
+
+  CompiledPattern(const CompiledPattern&);
+  CompiledPattern(CompiledPattern&&);
+  CompiledPattern& operator=(const CompiledPattern&);
+  CompiledPattern& operator=(CompiledPattern&&);
+
+  ~CompiledPattern();
+
+  bool Match(std::string_view string) const;
+
+ private:
+  friend class PatternSet;
+
+  struct Segment {
+    // The most characters that the wildcards before the literal match, or -1
+    // for any number.
+    int max_distance;
+    // The literal is [begin, begin + size) of |literals_|, with its escapes
+    // removed.
+    size_t begin;
+    size_t size;
+  };
+
+  std::string_view Literal(const Segment& segment) const {
+    return std::string_view(literals_).substr(segment.begin, segment.size);
+  }
+
+  std::string literals_;
+  // The last segment’s literal must end the string.
+  std::vector<Segment> segments_;
+  // MatchPattern() never matches a pattern with a literal character that is
+  // not valid UTF-8.
+  bool never_matches_ = false;
+  // A pattern that ends in an unpaired backslash, which MatchPattern() treats
+  // irregularly when it retries a later position, is kept to be matched by
+  // MatchPattern() itself.
+  std::string unpaired_escape_pattern_;
+};
+
+// A list of UTF-8 patterns, matched against a string together. The longest
+// literal of every pattern is searched for in a single Aho–Corasick pass over
+// the string, and only the patterns whose literal occurs, or which have none,
+// are then matched with CompiledPattern::Match(). Matching a string against a
+// few hundred patterns thus costs one scan plus a few full matches, rather
+// than a few hundred MatchPattern() calls.
+class PatternSet {
+ public:
+  static constexpr size_t kNoMatch = static_cast<size_t>(-1);
+
+  explicit PatternSet(span<const std::string_view> patterns);
+
+  PatternSet(const PatternSet&) = delete;
+  PatternSet& operator=(const PatternSet&) = delete;
+
+  ~PatternSet();
+
+  size_t size() const { return patterns_.size(); }
+
+  // Returns the index of the first pattern that |string| matches, or kNoMatch.
+  size_t FirstMatch(std::string_view string) const;
+
+  bool MatchesAny(std::string_view string) const {
+    return FirstMatch(string) != kNoMatch;
+  }
+
+ private:
+  std::vector<CompiledPattern> patterns_;
+
+  // Set in a transition to a state at which a literal ends.
+  static constexpr uint32_t kHasOutputs = uint32_t{1} << 31;
+
+  // Patterns without a literal, which every string must be matched against.
+  std::vector<uint32_t> unfiltered_;
+
+  // The automaton’s transitions, in states of |class_count_| entries, indexed
+  // by |byte_classes_|. Bytes that occur in no literal share class 0. Each
+  // transition is the index of the target state’s first entry, with
+  // kHasOutputs if any pattern’s literal ends there.
+  uint8_t byte_classes_[256];
+  size_t class_count_;
+  std::vector<uint32_t> transitions_;
+
+  // The patterns whose literal ends at the state at index i of |transitions_|
+  // are [output_begin_[j], output_begin_[j + 1]) of |outputs_|, where j is
+  // i / |class_count_|.
+  std::vector<uint32_t> output_begin_;
+  std::vector<uint32_t> outputs_;
+};
+
 }  // namespace base
 
 #endif  // BASE_STRINGS_PATTERN_H_
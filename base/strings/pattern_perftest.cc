@@ -0,0 +1,129 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/pattern.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace {
+
+// Paths like those that logging’s vmodule patterns are matched against.
+std::vector<std::string> MakePaths() {
+  static constexpr const char* kDirectories[] = {
+      "base", "base/strings", "net/http", "content/browser", "third_party/zlib",
+      "ui/views/controls", "chrome/browser/ui", "components/crash/core"};
+  static constexpr const char* kFiles[] = {
+      "logging.cc", "string_util.cc", "http_stream_parser.cc",
+      "render_frame_host_impl.cc", "inflate.c", "textfield.cc",
+      "browser_view.cc", "crash_report_database.cc"};
+  std::vector<std::string> paths;
+  for (const char* directory : kDirectories) {
+    for (const char* file : kFiles) {
+      paths.push_back(std::string("/src/chromium/") + directory + "/" + file);
+    }
+  }
+  return paths;
+}
+
+// Reports the time per path taken by |match| over all of |paths|.
+template <typename Match>
+void Report(const char* metric,
+            const char* story,
+            const std::vector<std::string>& paths,
+            Match match) {
+  const double ns = perf_test::MeasureNanosecondsPerCall([&] {
+    for (const std::string& path : paths) {
+      perf_test::DoNotOptimize(match(path));
+    }
+  });
+  perf_test::PrintResult(
+      metric, story, ns / static_cast<double>(paths.size()), "ns_per_string");
+}
+
+}  // namespace
+
+PERF_TEST(Pattern, CompiledPattern) {
+  const std::vector<std::string> paths = MakePaths();
+  static constexpr struct {
+    const char* story;
+    const char* pattern;
+  } kPatterns[] = {
+      {"suffix", "*/http_stream_parser.cc"},
+      {"infix", "*/browser/*"},
+      {"question_marks", "*/base/string_????.cc"},
+      {"no_match", "*/gpu/*/command_buffer*.cc"},
+  };
+
+  for (const auto& pattern : kPatterns) {
+    const CompiledPattern compiled(pattern.pattern);
+    Report("compiled_pattern", pattern.story, paths,
+           [&](std::string_view path) { return compiled.Match(path); });
+    Report("match_pattern", pattern.story, paths, [&](std::string_view path) {
+      return MatchPattern(path, pattern.pattern);
+    });
+  }
+
+  // A literal after a * found near the end of a long string.
+  std::string haystack(4096, 'x');
+  haystack.replace(4000, 10, "needle_xyz");
+  const std::vector<std::string> haystacks = {haystack};
+  const CompiledPattern needle("*needle_xyz*");
+  Report("compiled_pattern", "needle_in_4k", haystacks,
+         [&](std::string_view string) { return needle.Match(string); });
+  Report("match_pattern", "needle_in_4k", haystacks,
+         [&](std::string_view string) {
+           return MatchPattern(string, "*needle_xyz*");
+         });
+}
+
+PERF_TEST(Pattern, PatternSet) {
+  const std::vector<std::string> paths = MakePaths();
+
+  // About 300 patterns, few of which match anything, as in a long vmodule or
+  // filter list.
+  std::vector<std::string> pattern_storage;
+  for (size_t index = 0; index < 300; ++index) {
+    pattern_storage.push_back("*/module_" + std::to_string(index) + "/*.cc");
+  }
+  pattern_storage.push_back("*/net/*");
+  pattern_storage.push_back("*_impl.cc");
+  std::vector<std::string_view> patterns(pattern_storage.begin(),
+                                         pattern_storage.end());
+
+  const PatternSet pattern_set(patterns);
+  Report("first_match", "pattern_set", paths, [&](std::string_view path) {
+    return pattern_set.FirstMatch(path);
+  });
+
+  std::vector<CompiledPattern> compiled(patterns.begin(), patterns.end());
+  Report("first_match", "compiled_pattern_loop", paths,
+         [&](std::string_view path) {
+           for (size_t index = 0; index < compiled.size(); ++index) {
+             if (compiled[index].Match(path)) {
+               return index;
+             }
+           }
+           return PatternSet::kNoMatch;
+         });
+
+  Report("first_match", "match_pattern_loop", paths,
+         [&](std::string_view path) {
+           for (size_t index = 0; index < patterns.size(); ++index) {
+             if (MatchPattern(path, patterns[index])) {
+               return index;
+             }
+           }
+           return PatternSet::kNoMatch;
+         });
+}
+
+}  // namespace base
@@ -0,0 +1,35 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_STRINGS_SHORTEST_DECIMAL_H_
+#define MINI_CHROMIUM_BASE_STRINGS_SHORTEST_DECIMAL_H_
+
+#include <stdint.h>
+
+namespace base {
+namespace internal {
+
+// A decimal floating-point number, |digits| × 10^|exponent|.
+struct ShortestDecimal {
+  uint64_t digits;
+  int32_t exponent;
+};
+
+// Returns the decimal with the fewest digits that converts back to |value|,
+// and of those, the one closest to |value|. |value| must be finite and
+// positive. This is the Ryū algorithm (Ulf Adams, “Ryū: Fast Float-to-String
+// Conversion”, PLDI 2018), which needs only fixed-width integer arithmetic.
+ShortestDecimal ToShortestDecimal(double value);
+ShortestDecimal ToShortestDecimal(float value);
+
+// Returns |digits| × 10^|exponent| correctly rounded to the nearest double,
+// ties to even. |digits| must have at most 17 decimal digits. The result is
+// infinity if it is too large, and 0 if it is too small. This is Ryū’s
+// decimal-to-binary counterpart, and shares its tables.
+double DecimalToDouble(uint64_t digits, int32_t exponent);
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_STRINGS_SHORTEST_DECIMAL_H_
@@ -0,0 +1,409 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/str_format.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <wchar.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+#include "base/strings/strcat_internal.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+// A conversion with any width or precision taken from the arguments.
+struct ResolvedSpec {
+  char conversion;
+  uint8_t flags;
+  size_t width;
+  // Negative if there is none.
+  int32_t precision;
+  const FormatArg* arg;
+};
+
+ResolvedSpec Resolve(const FormatSpec& spec, const FormatArg** next_arg) {
+  ResolvedSpec resolved;
+  resolved.conversion = spec.conversion;
+  resolved.flags = spec.flags;
+
+  int64_t width = spec.width;
+  if (spec.width == kFormatFromArgument) {
+    // As in printf(), a negative width from an argument left-justifies.
+    width = (*next_arg)++->i;
+    if (width < 0) {
+      resolved.flags |= kFormatLeft;
+      width = -width;
+    }
+  }
+  resolved.width = width > 0 ? static_cast<size_t>(width) : 0;
+
+  int64_t precision = spec.precision;
+  if (spec.precision == kFormatFromArgument) {
+    precision = (*next_arg)++->i;
+  }
+  resolved.precision = precision >= 0
+                           ? static_cast<int32_t>(std::min<int64_t>(
+                                 precision, std::numeric_limits<int32_t>::max()))
+                           : -1;
+
+  resolved.arg = (*next_arg)++;
+  return resolved;
+}
+
+bool IsIntegerConversion(char conversion) {
+  return strchr("diouxXc", conversion) != nullptr;
+}
+
+std::string_view StringArg(const FormatArg& arg, int32_t precision) {
+  std::string_view value =
+      arg.s.data ? std::string_view(arg.s.data, arg.s.length) : "(null)";
+  if (precision >= 0 && static_cast<size_t>(precision) < value.size()) {
+    value = value.substr(0, static_cast<size_t>(precision));
+  }
+  return value;
+}
+
+bool IsSignedConversion(char conversion) {
+  return conversion == 'd' || conversion == 'i';
+}
+
+// Returns the magnitude of an integer argument to |spec|, and whether it is
+// printed as negative.
+uint64_t IntegerMagnitude(const ResolvedSpec& spec, bool* negative) {
+  const FormatArg& arg = *spec.arg;
+  *negative = false;
+  if (arg.type == FormatArgType::kUnsigned) {
+    return arg.u;
+  }
+  if (IsSignedConversion(spec.conversion)) {
+    *negative = arg.i < 0;
+    return *negative ? 0 - static_cast<uint64_t>(arg.i)
+                     : static_cast<uint64_t>(arg.i);
+  }
+  // As printf() would see it, reinterpreted as unsigned of the same size.
+  uint64_t magnitude = static_cast<uint64_t>(arg.i);
+  if (arg.size < sizeof(uint64_t)) {
+    magnitude &= (uint64_t{1} << (arg.size * 8)) - 1;
+  }
+  return magnitude;
+}
+
+unsigned IntegerBase(char conversion) {
+  if (conversion == 'o') {
+    return 8;
+  }
+  if (conversion == 'x' || conversion == 'X') {
+    return 16;
+  }
+  return 10;
+}
+
+// Returns at least the number of characters that |spec| produces, without its
+// padding to the width.
+size_t MaxConversionLength(const ResolvedSpec& spec) {
+  const size_t precision =
+      spec.precision >= 0 ? static_cast<size_t>(spec.precision) : 6;
+  switch (spec.conversion) {
+    case 'c':
+      return 1;
+    case 's':
+      return StringArg(*spec.arg, spec.precision).size();
+    case 'C':
+      return MB_LEN_MAX;
+    case 'S': {
+      // Each wide character is at most MB_LEN_MAX bytes, and the precision
+      // limits the bytes.
+      const size_t length =
+          spec.arg->ws ? wcslen(spec.arg->ws) * MB_LEN_MAX : strlen("(null)");
+      return spec.precision >= 0 ? std::min(length, precision) : length;
+    }
+    case 'p':
+      // A sign, “0x”, and the digits, which the precision can extend.
+      return 3 + std::max<size_t>(spec.precision >= 0 ? precision : 0,
+                                  2 * sizeof(void*));
+    case 'f':
+    case 'F':
+      if (std::isfinite(spec.arg->d) && spec.arg->d != 0) {
+        // The integer part has about log10(2) digits per bit of its binary
+        // exponent. Add the sign, the point and the fraction.
+        const int exponent = std::max(std::ilogb(spec.arg->d) + 1, 1);
+        return static_cast<size_t>(exponent) * 30103 / 100000 + 4 + precision;
+      }
+      return 5 + precision;
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      // At most a sign, “0x”, a point, an exponent such as “e+308” or
+      // “p-1074”, and the digits, which %a can have 13 of by default.
+      return 12 + std::max<size_t>(precision, 13);
+    default: {
+      // A sign or “0x”, and the digits or the precision, whichever is more.
+      // The digits are estimated from the magnitude’s bit length, and only
+      // ever overestimated, so that a short result stays in a short string.
+      bool negative;
+      const int bits =
+          std::bit_width(IntegerMagnitude(spec, &negative) | 1);
+      size_t digits;
+      switch (IntegerBase(spec.conversion)) {
+        case 8:
+          // %#o adds a digit.
+          digits = static_cast<size_t>(bits + 2) / 3 + 1;
+          break;
+        case 16:
+          digits = static_cast<size_t>(bits + 3) / 4;
+          break;
+        default:
+          digits = static_cast<size_t>(bits * 1233 >> 12) + 1;
+          break;
+      }
+      return 2 + std::max<size_t>(spec.precision >= 0 ? precision : 0, digits);
+    }
+  }
+}
+
+char* WritePadding(char* out, size_t count, char c) {
+  memset(out, c, count);
+  return out + count;
+}
+
+// Writes |text| padded to the width of |spec|.
+char* WritePadded(char* out, const ResolvedSpec& spec, std::string_view text) {
+  const size_t padding =
+      spec.width > text.size() ? spec.width - text.size() : 0;
+  if (!(spec.flags & kFormatLeft)) {
+    out = WritePadding(out, padding, ' ');
+  }
+  memcpy(out, text.data(), text.size());
+  out += text.size();
+  if (spec.flags & kFormatLeft) {
+    out = WritePadding(out, padding, ' ');
+  }
+  return out;
+}
+
+// Writes the digits of |value| to the characters before |end|, and returns the
+// first. The base is a constant so that dividing by it is cheap.
+template <unsigned kBase>
+char* WriteDigitsBackward(uint64_t value, char* end, const char* digit_chars) {
+  do {
+    *--end = digit_chars[value % kBase];
+    value /= kBase;
+  } while (value != 0);
+  return end;
+}
+
+char* WriteInteger(char* out, const ResolvedSpec& spec) {
+  const char conversion = spec.conversion;
+  const bool is_signed_conversion = IsSignedConversion(conversion);
+  bool negative;
+  const uint64_t magnitude = IntegerMagnitude(spec, &negative);
+
+  if (conversion == 'c') {
+    const char c = static_cast<char>(magnitude);
+    return WritePadded(out, spec, std::string_view(&c, 1));
+  }
+
+  const char* const digit_chars =
+      conversion == 'X' ? "0123456789ABCDEF" : "0123456789abcdef";
+  char digit_buffer[24];
+  char* const digits_end = std::end(digit_buffer);
+  char* digits = digits_end;
+  // With a precision of 0, the value 0 has no digits.
+  if (magnitude != 0 || spec.precision != 0) {
+    switch (IntegerBase(conversion)) {
+      case 8:
+        digits = WriteDigitsBackward<8>(magnitude, digits_end, digit_chars);
+        break;
+      case 16:
+        digits = WriteDigitsBackward<16>(magnitude, digits_end, digit_chars);
+        break;
+      default:
+        digits = WriteDigitsBackward<10>(magnitude, digits_end, digit_chars);
+        break;
+    }
+  }
+  const size_t digit_count = static_cast<size_t>(digits_end - digits);
+
+  size_t precision = spec.precision >= 0 ? static_cast<size_t>(spec.precision)
+                                         : 0;
+  if (conversion == 'o' && (spec.flags & kFormatAlternate) &&
+      (digit_count == 0 || *digits != '0')) {
+    // %#o always starts with a 0.
+    precision = std::max(precision, digit_count + 1);
+  }
+
+  if (spec.flags == 0 && spec.width == 0 && spec.precision < 0) {
+    // The common case, with nothing to pad.
+    if (negative) {
+      *out++ = '-';
+    }
+    memcpy(out, digits, digit_count);
+    return out + digit_count;
+  }
+
+  char prefix[2];
+  size_t prefix_length = 0;
+  if (is_signed_conversion) {
+    if (negative) {
+      prefix[prefix_length++] = '-';
+    } else if (spec.flags & kFormatPlus) {
+      prefix[prefix_length++] = '+';
+    } else if (spec.flags & kFormatSpace) {
+      prefix[prefix_length++] = ' ';
+    }
+  } else if ((conversion == 'x' || conversion == 'X') &&
+             (spec.flags & kFormatAlternate) && digit_count != 0 &&
+             *digits != '0') {
+    prefix[prefix_length++] = '0';
+    prefix[prefix_length++] = conversion;
+  }
+
+  size_t zeros = precision > digit_count ? precision - digit_count : 0;
+  const size_t length = prefix_length + zeros + digit_count;
+  size_t padding = spec.width > length ? spec.width - length : 0;
+  if ((spec.flags & kFormatZero) && !(spec.flags & kFormatLeft) &&
+      spec.precision < 0) {
+    zeros += padding;
+    padding = 0;
+  }
+
+  if (!(spec.flags & kFormatLeft)) {
+    out = WritePadding(out, padding, ' ');
+  }
+  memcpy(out, prefix, prefix_length);
+  out += prefix_length;
+  out = WritePadding(out, zeros, '0');
+  memcpy(out, digits, digit_count);
+  out += digit_count;
+  if (spec.flags & kFormatLeft) {
+    out = WritePadding(out, padding, ' ');
+  }
+  return out;
+}
+
+// Formats a floating-point value, pointer, or wide character or string with
+// snprintf() into |out|, which has room for |size| characters including a
+// terminator.
+char* WriteWithSnprintf(char* out, size_t size, const ResolvedSpec& spec) {
+  char format[16];
+  char* f = format;
+  *f++ = '%';
+  for (const auto& [flag, c] : {std::pair(kFormatLeft, '-'),
+                               std::pair(kFormatPlus, '+'),
+                               std::pair(kFormatSpace, ' '),
+                               std::pair(kFormatAlternate, '#'),
+                               std::pair(kFormatZero, '0')}) {
+    if (spec.flags & flag) {
+      *f++ = c;
+    }
+  }
+  // A width of 0 pads nothing, and a negative precision is ignored.
+  memcpy(f, "*.*", 3);
+  f += 3;
+  if (spec.conversion == 'S' || spec.conversion == 'C') {
+    *f++ = 'l';
+    *f++ = spec.conversion == 'S' ? 's' : 'c';
+  } else {
+    *f++ = spec.conversion;
+  }
+  *f = '\0';
+
+  const int width = static_cast<int>(spec.width);
+  int length;
+  switch (spec.conversion) {
+    case 'p':
+      length = snprintf(out, size, format, width, spec.precision, spec.arg->p);
+      break;
+    case 'S':
+      length = snprintf(out, size, format, width, spec.precision, spec.arg->ws);
+      break;
+    case 'C':
+      length = snprintf(out, size, format, width, spec.precision,
+                        static_cast<wint_t>(spec.arg->u));
+      break;
+    default:
+      length = snprintf(out, size, format, width, spec.precision, spec.arg->d);
+      break;
+  }
+  return length > 0 ? out + std::min(static_cast<size_t>(length), size - 1)
+                    : out;
+}
+
+char* WriteLiteral(char* out, std::string_view text, bool escaped) {
+  if (!escaped) {
+    memcpy(out, text.data(), text.size());
+    return out + text.size();
+  }
+  for (size_t i = 0; i < text.size(); ++i) {
+    *out++ = text[i];
+    if (text[i] == '%') {
+      // Skip the second '%' of “%%”.
+      ++i;
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+void AppendFormat(std::string* output,
+                  const char* format,
+                  const FormatSpec* specs,
+                  std::initializer_list<FormatArg> args) {
+  // Find an upper bound on the length of the result, counting the literal
+  // text with its “%%” escapes, and leaving room for snprintf()’s terminator.
+  size_t max_length = 1;
+  const FormatArg* next_arg = args.begin();
+  for (const FormatSpec* spec = specs;; ++spec) {
+    max_length += spec->literal_end - spec->literal_begin;
+    if (spec->conversion == '\0') {
+      break;
+    }
+    const ResolvedSpec resolved = Resolve(*spec, &next_arg);
+    max_length += std::max(resolved.width, MaxConversionLength(resolved));
+  }
+
+  const size_t old_size = output->size();
+  Resize(*output, old_size + max_length, priority_tag<1>());
+  char* out = output->data() + old_size;
+  char* const end = output->data() + output->size();
+  next_arg = args.begin();
+  for (const FormatSpec* spec = specs;; ++spec) {
+    out = WriteLiteral(
+        out,
+        std::string_view(format + spec->literal_begin,
+                         spec->literal_end - spec->literal_begin),
+        spec->literal_escaped);
+    if (spec->conversion == '\0') {
+      break;
+    }
+    const ResolvedSpec resolved = Resolve(*spec, &next_arg);
+    if (IsIntegerConversion(spec->conversion)) {
+      out = WriteInteger(out, resolved);
+    } else if (spec->conversion == 's') {
+      out = WritePadded(out, resolved,
+                        StringArg(*resolved.arg, resolved.precision));
+    } else {
+      out = WriteWithSnprintf(out, static_cast<size_t>(end - out), resolved);
+    }
+  }
+  output->resize(static_cast<size_t>(out - output->data()));
+}
+
+}  // namespace internal
+}  // namespace base
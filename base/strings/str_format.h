@@ -0,0 +1,357 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_STRINGS_STR_FORMAT_H_
+#define MINI_CHROMIUM_BASE_STRINGS_STR_FORMAT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <wchar.h>
+
+#include <array>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// StrFormat() formats its arguments with a printf-style format string, which
+// is parsed and checked against the argument types at compile time:
+//
+//   std::string s = base::StrFormat("%s: %d of %zu (%.1f%%)", name, i, n, pct);
+//
+// The wrong number of arguments, or an argument of the wrong kind for its
+// conversion, such as a string for %d, is a compile error. Length modifiers
+// such as l and z are accepted but ignored, since each argument’s own type is
+// known. %d prints the value of any integer; %u, %o and %x print a negative one
+// as printf() would for an argument of the same size. %s takes a C string,
+// std::string or std::string_view, %ls a wide C string or std::wstring, and %p
+// takes any pointer. %n is rejected.
+//
+// The result’s size is estimated once from the parsed format and the arguments,
+// and everything is written straight into it, so nothing is formatted twice.
+// Floating-point values, pointers, and wide characters and strings are
+// formatted by snprintf(), and so follow the locale as printf() does.
+
+namespace base {
+namespace internal {
+
+enum class FormatArgType : uint8_t {
+  kSigned,
+  kUnsigned,
+  kDouble,
+  kString,
+  kWideString,
+  kPointer,
+};
+
+// One argument to StrFormat(), captured without formatting it.
+struct FormatArg {
+  template <typename T>
+    requires(std::is_integral_v<T> && std::is_signed_v<T>)
+  constexpr FormatArg(T value)
+      : type(FormatArgType::kSigned), size(sizeof(T)), i(value) {}
+
+  template <typename T>
+    requires(std::is_integral_v<T> && !std::is_signed_v<T>)
+  constexpr FormatArg(T value)
+      : type(FormatArgType::kUnsigned), size(sizeof(T)), u(value) {}
+
+  template <typename T>
+    requires(std::is_enum_v<T>)
+  constexpr FormatArg(T value)
+      : FormatArg(static_cast<std::underlying_type_t<T>>(value)) {}
+
+  template <typename T>
+    requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+  constexpr FormatArg(T value)
+      : type(FormatArgType::kDouble), size(sizeof(T)), d(value) {}
+
+  FormatArg(const char* value)
+      : type(FormatArgType::kString),
+        size(0),
+        s{value, value ? strlen(value) : 0} {}
+
+  FormatArg(std::string_view value)
+      : type(FormatArgType::kString),
+        size(0),
+        s{value.data(), value.size()} {}
+
+  FormatArg(const wchar_t* value)
+      : type(FormatArgType::kWideString), size(0), ws(value) {}
+
+  FormatArg(const std::wstring& value)
+      : type(FormatArgType::kWideString), size(0), ws(value.c_str()) {}
+
+  template <typename T>
+    requires(!std::is_same_v<std::remove_cv_t<T>, char> &&
+             !std::is_same_v<std::remove_cv_t<T>, wchar_t>)
+  constexpr FormatArg(T* value)
+      : type(FormatArgType::kPointer), size(sizeof(T*)), p(value) {}
+
+  constexpr FormatArg(std::nullptr_t)
+      : type(FormatArgType::kPointer), size(sizeof(void*)), p(nullptr) {}
+
+  FormatArgType type;
+  // The size of the argument’s original type.
+  uint8_t size;
+  union {
+    int64_t i;
+    uint64_t u;
+    double d;
+    struct {
+      const char* data;
+      size_t length;
+    } s;
+    // Terminated, as snprintf() requires.
+    const wchar_t* ws;
+    const void* p;
+  };
+};
+
+template <typename T>
+consteval FormatArgType FormatArgTypeOf() {
+  using U = std::remove_cvref_t<T>;
+  if constexpr (std::is_enum_v<U>) {
+    return FormatArgTypeOf<std::underlying_type_t<U>>();
+  } else if constexpr (std::is_integral_v<U>) {
+    return std::is_signed_v<U> ? FormatArgType::kSigned
+                               : FormatArgType::kUnsigned;
+  } else if constexpr (std::is_same_v<U, float> || std::is_same_v<U, double>) {
+    return FormatArgType::kDouble;
+  } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+    return FormatArgType::kString;
+  } else if constexpr (std::is_convertible_v<const U&, const wchar_t*> ||
+                       std::is_same_v<U, std::wstring>) {
+    return FormatArgType::kWideString;
+  } else {
+    static_assert(std::is_pointer_v<U> || std::is_null_pointer_v<U>,
+                  "unsupported StrFormat() argument type");
+    return FormatArgType::kPointer;
+  }
+}
+
+inline constexpr uint8_t kFormatLeft = 1 << 0;
+inline constexpr uint8_t kFormatPlus = 1 << 1;
+inline constexpr uint8_t kFormatSpace = 1 << 2;
+inline constexpr uint8_t kFormatAlternate = 1 << 3;
+inline constexpr uint8_t kFormatZero = 1 << 4;
+
+// Values of FormatSpec::width and precision other than a number.
+inline constexpr int32_t kFormatNone = -1;
+inline constexpr int32_t kFormatFromArgument = -2;
+
+// A conversion in a format string, and the literal text before it. The last
+// FormatSpec of a format string has no conversion, and holds the text after
+// the last one.
+struct FormatSpec {
+  // The literal text is [literal_begin, literal_end) of the format string,
+  // and contains “%%” only if |literal_escaped|.
+  uint32_t literal_begin = 0;
+  uint32_t literal_end = 0;
+  bool literal_escaped = false;
+  // '\0' for the last FormatSpec.
+  char conversion = '\0';
+  uint8_t flags = 0;
+  int32_t width = kFormatNone;
+  int32_t precision = kFormatNone;
+};
+
+// These are not constexpr, so a call to one during the compile-time parse of
+// a format string is an error naming the problem.
+inline void FormatStringHasTooFewArguments() {}
+inline void FormatStringHasTooManyArguments() {}
+inline void FormatStringHasInvalidConversion() {}
+inline void FormatStringArgumentDoesNotMatchConversion() {}
+inline void FormatStringWidthOrPrecisionTooLarge() {}
+
+constexpr bool IsFormatArgTypeAllowed(char conversion, FormatArgType type) {
+  switch (conversion) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'c':
+      return type == FormatArgType::kSigned || type == FormatArgType::kUnsigned;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      return type == FormatArgType::kDouble;
+    case 's':
+      return type == FormatArgType::kString;
+    case 'S':
+      return type == FormatArgType::kWideString;
+    case 'C':
+      return type == FormatArgType::kSigned || type == FormatArgType::kUnsigned;
+    case 'p':
+      return type == FormatArgType::kPointer;
+    default:
+      FormatStringHasInvalidConversion();
+      return false;
+  }
+}
+
+// Parses |format| into |specs|, checking it against the |arg_count| argument
+// types at |arg_types|. There is at most one FormatSpec for each argument, plus
+// the last.
+consteval void ParseFormatString(const char* format,
+                                   const FormatArgType* arg_types,
+                                   size_t arg_count,
+                                   FormatSpec* specs) {
+  size_t spec_count = 0;
+  size_t arg = 0;
+  const auto take_arg = [&](char conversion) {
+    if (arg == arg_count) {
+      FormatStringHasTooFewArguments();
+    }
+    if (!IsFormatArgTypeAllowed(conversion, arg_types[arg])) {
+      FormatStringArgumentDoesNotMatchConversion();
+    }
+    ++arg;
+  };
+  // Parses a width or precision at |format[*i]|, taking an argument for '*'.
+  const auto parse_number = [&](uint32_t* i) -> int32_t {
+    if (format[*i] == '*') {
+      ++*i;
+      take_arg('d');
+      return kFormatFromArgument;
+    }
+    int32_t value = 0;
+    for (; format[*i] >= '0' && format[*i] <= '9'; ++*i) {
+      value = value * 10 + (format[*i] - '0');
+      if (value > 1000000) {
+        FormatStringWidthOrPrecisionTooLarge();
+      }
+    }
+    return value;
+  };
+
+  FormatSpec spec;
+  uint32_t i = 0;
+  while (format[i] != '\0') {
+    if (format[i] != '%') {
+      ++i;
+      continue;
+    }
+    if (format[i + 1] == '%') {
+      spec.literal_escaped = true;
+      i += 2;
+      continue;
+    }
+    spec.literal_end = i++;
+
+    for (;; ++i) {
+      if (format[i] == '-') {
+        spec.flags |= kFormatLeft;
+      } else if (format[i] == '+') {
+        spec.flags |= kFormatPlus;
+      } else if (format[i] == ' ') {
+        spec.flags |= kFormatSpace;
+      } else if (format[i] == '#') {
+        spec.flags |= kFormatAlternate;
+      } else if (format[i] == '0') {
+        spec.flags |= kFormatZero;
+      } else {
+        break;
+      }
+    }
+    if (format[i] == '*' || (format[i] >= '1' && format[i] <= '9')) {
+      spec.width = parse_number(&i);
+    }
+    if (format[i] == '.') {
+      ++i;
+      spec.precision = parse_number(&i);
+    }
+    bool wide = false;
+    while (format[i] == 'h' || format[i] == 'l' || format[i] == 'L' ||
+           format[i] == 'q' || format[i] == 'j' || format[i] == 'z' ||
+           format[i] == 't') {
+      wide |= format[i] == 'l';
+      ++i;
+    }
+    spec.conversion = format[i];
+    // %ls and %lc are held as their synonyms %S and %C.
+    if (wide && spec.conversion == 's') {
+      spec.conversion = 'S';
+    } else if (wide && spec.conversion == 'c') {
+      spec.conversion = 'C';
+    }
+    if (spec.conversion == '\0') {
+      FormatStringHasInvalidConversion();
+    }
+    take_arg(spec.conversion);
+    ++i;
+
+    specs[spec_count++] = spec;
+    spec = FormatSpec();
+    spec.literal_begin = i;
+  }
+  spec.literal_end = i;
+  specs[spec_count++] = spec;
+
+  if (arg != arg_count) {
+    FormatStringHasTooManyArguments();
+  }
+}
+
+// Formats |args| with |format|, parsed into |specs|, and appends the result to
+// |*output|.
+void AppendFormat(std::string* output,
+                  const char* format,
+                  const FormatSpec* specs,
+                  std::initializer_list<FormatArg> args);
+
+}  // namespace internal
+
+// A format string for arguments of type |Args|, parsed and checked when it is
+// constructed at compile time, usually implicitly from a string literal.
+template <typename... Args>
+class FormatString {
+ public:
+  consteval FormatString(const char* format) : format_(format) {
+    constexpr std::array<internal::FormatArgType, sizeof...(Args)> kArgTypes =
+        {internal::FormatArgTypeOf<Args>()...};
+    internal::ParseFormatString(format, kArgTypes.data(), kArgTypes.size(),
+                                specs_.data());
+  }
+
+  const char* format() const { return format_; }
+
+  // Ends with the FormatSpec without a conversion.
+  const internal::FormatSpec* specs() const { return specs_.data(); }
+
+ private:
+  const char* format_;
+  std::array<internal::FormatSpec, sizeof...(Args) + 1> specs_;
+};
+
+template <typename... Args>
+[[nodiscard]] std::string StrFormat(
+    const FormatString<std::type_identity_t<Args>...>& format,
+    const Args&... args) {
+  std::string result;
+  internal::AppendFormat(&result, format.format(), format.specs(),
+                         {internal::FormatArg(args)...});
+  return result;
+}
+
+// Like StrFormat(), but appends to |*output|.
+template <typename... Args>
+void StrAppendFormat(std::string* output,
+                     const FormatString<std::type_identity_t<Args>...>& format,
+                     const Args&... args) {
+  internal::AppendFormat(output, format.format(), format.specs(),
+                         {internal::FormatArg(args)...});
+}
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_STRINGS_STR_FORMAT_H_
@@ -15,4 +15,16 @@ std::string StrCat(span<const std::string_view> pieces) {
   return internal::StrCatT(pieces);
 }
 
+std::u16string StrCat(span<const std::u16string_view> pieces) {
+  return internal::StrCatT(pieces);
+}
+
+void StrAppend(std::string* dest, span<const std::string_view> pieces) {
+  internal::StrAppendT(*dest, pieces);
+}
+
+void StrAppend(std::u16string* dest, span<const std::u16string_view> pieces) {
+  internal::StrAppendT(*dest, pieces);
+}
+
 }  // namespace base
@@ -5,10 +5,18 @@
 #ifndef BASE_STRINGS_STRCAT_H_
 #define BASE_STRINGS_STRCAT_H_
 
+#include <stddef.h>
+
+#include <algorithm>
+#include <concepts>
 #include <initializer_list>
+#include <string>
 #include <string_view>
+#include <type_traits>
 
 #include "base/containers/span.h"
+#include "base/files/file_path.h"
+#include "base/strings/string_number_conversions.h"
 #include "build/build_config.h"
 
 #if BUILDFLAG(IS_WIN)
@@ -55,12 +63,129 @@ namespace base {
 // we can explore more in the future.
 
 [[nodiscard]] std::string StrCat(span<const std::string_view> pieces);
+[[nodiscard]] std::u16string StrCat(span<const std::u16string_view> pieces);
 
 // Initializer list forwards to the array version.
 inline std::string StrCat(std::initializer_list<std::string_view> pieces) {
   return StrCat(make_span(pieces));
 }
 
+inline std::u16string StrCat(
+    std::initializer_list<std::u16string_view> pieces) {
+  return StrCat(make_span(pieces));
+}
+
+// StrAppend -------------------------------------------------------------------
+//
+// Appends a sequence of strings to a destination. Prefer:
+//   StrAppend(&foo, {"bar", " baz"});
+// to:
+//   foo += "bar";
+//   foo += " baz";
+// since the former grows |foo| only once.
+
+void StrAppend(std::string* dest, span<const std::string_view> pieces);
+void StrAppend(std::u16string* dest, span<const std::u16string_view> pieces);
+
+inline void StrAppend(std::string* dest,
+                      std::initializer_list<std::string_view> pieces) {
+  StrAppend(dest, make_span(pieces));
+}
+
+inline void StrAppend(std::u16string* dest,
+                      std::initializer_list<std::u16string_view> pieces) {
+  StrAppend(dest, make_span(pieces));
+}
+
+// AlphaNum --------------------------------------------------------------------
+//
+// A piece of the variadic StrCat() and StrAppend() below: a string, or a
+// number formatted into the AlphaNum itself as by NumberToString(), so that no
+// temporary std::string is made for it. Where FilePath holds narrow strings,
+// a FilePath’s value can be a piece too:
+//
+//   std::string s = base::StrCat("frame ", index, " took ", ms, " ms");
+//   base::StrAppend(&log, path, ": ", size, " bytes");
+//
+// An AlphaNum is meant to be a temporary, only ever built implicitly for an
+// argument. A character, which would otherwise print as a number, is rejected,
+// as is a bool.
+template <typename CharT>
+class BasicAlphaNum {
+ public:
+  using StringViewT = std::basic_string_view<CharT>;
+
+  BasicAlphaNum(StringViewT value) : piece_(value) {}
+  BasicAlphaNum(const CharT* value) : piece_(value) {}
+  BasicAlphaNum(const std::basic_string<CharT>& value) : piece_(value) {}
+
+  BasicAlphaNum(const FilePath& path)
+    requires(std::is_same_v<CharT, FilePath::CharType>)
+      : piece_(path.value()) {}
+
+  template <typename T>
+    requires(std::integral<T> && !std::same_as<T, bool> &&
+             !std::same_as<T, char> && !std::same_as<T, wchar_t> &&
+             !std::same_as<T, char8_t> && !std::same_as<T, char16_t> &&
+             !std::same_as<T, char32_t>)
+  BasicAlphaNum(T value) : piece_(Format(value)) {}
+
+  BasicAlphaNum(double value) : piece_(Format(value)) {}
+  BasicAlphaNum(float value) : piece_(Format(value)) {}
+
+  BasicAlphaNum(char value) = delete;
+  BasicAlphaNum(bool value) = delete;
+
+  BasicAlphaNum(const BasicAlphaNum&) = delete;
+  BasicAlphaNum& operator=(const BasicAlphaNum&) = delete;
+
+  StringViewT Piece() const { return piece_; }
+
+ private:
+  template <typename T>
+  StringViewT Format(T value) {
+    if constexpr (std::is_same_v<CharT, char>) {
+      return StringViewT(buffer_, NumberToChars(value, buffer_));
+    } else {
+      char narrow[kMaxDoubleStringLength];
+      const size_t length = NumberToChars(value, narrow);
+      std::copy(narrow, narrow + length, buffer_);
+      return StringViewT(buffer_, length);
+    }
+  }
+
+  StringViewT piece_;
+  // Large enough for any integer or floating-point number.
+  CharT buffer_[kMaxDoubleStringLength];
+};
+
+using AlphaNum = BasicAlphaNum<char>;
+using AlphaNum16 = BasicAlphaNum<char16_t>;
+
+// Variadic StrCat() and StrAppend() accept anything that converts to an
+// AlphaNum, and, like the versions above, size the result once. StrCat()
+// produces a std::string; StrAppend() matches |dest|.
+template <typename... Pieces>
+  requires(sizeof...(Pieces) > 0 &&
+           (std::constructible_from<AlphaNum, const Pieces&> && ...))
+[[nodiscard]] std::string StrCat(const Pieces&... pieces) {
+  return StrCat({AlphaNum(pieces).Piece()...});
+}
+
+template <typename... Pieces>
+  requires(sizeof...(Pieces) > 0 &&
+           (std::constructible_from<AlphaNum, const Pieces&> && ...))
+void StrAppend(std::string* dest, const Pieces&... pieces) {
+  StrAppend(dest, {AlphaNum(pieces).Piece()...});
+}
+
+template <typename... Pieces>
+  requires(sizeof...(Pieces) > 0 &&
+           (std::constructible_from<AlphaNum16, const Pieces&> && ...))
+void StrAppend(std::u16string* dest, const Pieces&... pieces) {
+  StrAppend(dest, {AlphaNum16(pieces).Piece()...});
+}
+
 }  // namespace base
 
 #endif  // BASE_STRINGS_STRCAT_H_
@@ -42,10 +42,14 @@ void Resize(std::basic_string<CharT>& str, size_t total_size, priority_tag<0>) {
 //    avoids having to write the terminating '\0' character n times.
 template <typename CharT, typename StringT>
 void StrAppendT(std::basic_string<CharT>& dest, span<const StringT> pieces) {
+  // Pointers rather than span iterators, whose checks would dominate for the
+  // short pieces that are typical here.
+  const StringT* const begin = pieces.data();
+  const StringT* const end = begin + pieces.size();
   const size_t initial_size = dest.size();
   size_t total_size = initial_size;
-  for (const auto& cur : pieces)
-    total_size += cur.size();
+  for (const StringT* cur = begin; cur != end; ++cur)
+    total_size += cur->size();
 
   // Note: As opposed to `reserve()` calling `resize()` with an argument smaller
   // than the current `capacity()` does not result in the string releasing spare
@@ -56,9 +60,9 @@ void StrAppendT(std::basic_string<CharT>& dest, span<const StringT> pieces) {
   // performance hits in case `StrAppend()` gets called in a loop.
   Resize(dest, total_size, priority_tag<1>());
   CharT* dest_char = &dest[initial_size];
-  for (const auto& cur : pieces) {
-    std::char_traits<CharT>::copy(dest_char, cur.data(), cur.size());
-    dest_char += cur.size();
+  for (const StringT* cur = begin; cur != end; ++cur) {
+    std::char_traits<CharT>::copy(dest_char, cur->data(), cur->size());
+    dest_char += cur->size();
   }
 }
 
@@ -6,14 +6,223 @@
 
 #include <ctype.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include <bit>
+#include <cmath>
 #include <limits>
+#include <memory>
 #include <string_view>
 
+#include "base/numerics/checked_math.h"
+#include "base/strings/shortest_decimal.h"
+#include "base/strings/strcat_internal.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace base {
 
 namespace {
 
+// "00", "01", ... "99", so that digits can be written two at a time.
+constexpr char kDigitPairs[] =
+    "000102030405060708091011121314151617181920212223242526272829"
+    "303132333435363738394041424344454647484950515253545556575859"
+    "606162636465666768697071727374757677787980818283848586878889"
+    "90919293949596979899";
+
+constexpr uint64_t kPowersOf10[] = {
+    1u,
+    10u,
+    100u,
+    1000u,
+    10000u,
+    100000u,
+    1000000u,
+    10000000u,
+    100000000u,
+    1000000000u,
+    10000000000u,
+    100000000000u,
+    1000000000000u,
+    10000000000000u,
+    100000000000000u,
+    1000000000000000u,
+    10000000000000000u,
+    100000000000000000u,
+    1000000000000000000u,
+    10000000000000000000u,
+};
+
+size_t DecimalDigitCount(uint64_t value) {
+  if (value < 10) {
+    return 1;
+  }
+  // log10(2) is about 1233 / 4096, so |guess| is the number of digits of the
+  // largest number with fewer bits than |value|. |value| has either as many
+  // digits or one more.
+  const size_t bits = static_cast<size_t>(64 - std::countl_zero(value));
+  const size_t guess = (bits * 1233) >> 12;
+  return guess + (value >= kPowersOf10[guess] ? 1 : 0);
+}
+
+// Writes the decimal digits of |value| to the characters before |end|.
+template <typename CharT>
+void WriteDigitsBackward(uint64_t value, CharT* end) {
+  while (value >= 100) {
+    const char* pair = &kDigitPairs[(value % 100) * 2];
+    value /= 100;
+    *--end = static_cast<CharT>(pair[1]);
+    *--end = static_cast<CharT>(pair[0]);
+  }
+  if (value >= 10) {
+    const char* pair = &kDigitPairs[value * 2];
+    *--end = static_cast<CharT>(pair[1]);
+    *--end = static_cast<CharT>(pair[0]);
+  } else {
+    *--end = static_cast<CharT>('0' + value);
+  }
+}
+
+// Writes |magnitude|, preceded by a minus sign if |negative|, to |output|,
+// which must have room for |length| characters, the length of the result.
+template <typename CharT>
+void WriteNumber(uint64_t magnitude,
+                 bool negative,
+                 size_t length,
+                 CharT* output) {
+  if (negative) {
+    output[0] = '-';
+  }
+  WriteDigitsBackward(magnitude, output + length);
+}
+
+template <typename StringT>
+void AppendNumberImpl(uint64_t magnitude, bool negative, StringT* output) {
+  const size_t old_size = output->size();
+  const size_t length = (negative ? 1 : 0) + DecimalDigitCount(magnitude);
+  internal::Resize(*output, old_size + length, internal::priority_tag<1>());
+  WriteNumber(magnitude, negative, length, output->data() + old_size);
+}
+
+size_t NumberToCharsImpl(uint64_t magnitude, bool negative, span<char> output) {
+  const size_t length = (negative ? 1 : 0) + DecimalDigitCount(magnitude);
+  if (length > output.size()) {
+    return 0;
+  }
+  WriteNumber(magnitude, negative, length, output.data());
+  return length;
+}
+
+uint64_t Magnitude(int64_t value) {
+  return value < 0 ? 0 - static_cast<uint64_t>(value)
+                   : static_cast<uint64_t>(value);
+}
+
+template <typename StringT, typename T>
+StringT IntegerToString(T value) {
+  StringT result;
+  if constexpr (std::is_signed_v<T>) {
+    AppendNumberImpl(Magnitude(value), value < 0, &result);
+  } else {
+    AppendNumberImpl(value, false, &result);
+  }
+  return result;
+}
+
+// Writes |value|, formatted as by NumberToString(double), to |output|, which
+// must have room for kMaxDoubleStringLength characters. Returns the length.
+template <typename CharT, typename FloatT>
+size_t WriteFloatingPoint(FloatT value, CharT* output) {
+  CharT* out = output;
+  const auto put = [&out](std::string_view text) {
+    for (char c : text) {
+      *out++ = static_cast<CharT>(c);
+    }
+  };
+  const auto put_zeros = [&out](int count) {
+    for (int i = 0; i < count; ++i) {
+      *out++ = '0';
+    }
+  };
+
+  if (std::isnan(value)) {
+    put("NaN");
+    return 3;
+  }
+  if (std::signbit(value)) {
+    *out++ = '-';
+    value = -value;
+  }
+  if (std::isinf(value)) {
+    put("Infinity");
+  } else if (value == 0) {
+    *out++ = '0';
+  } else {
+    const internal::ShortestDecimal decimal =
+        internal::ToShortestDecimal(value);
+    char digit_buffer[kMaxIntegerStringLength];
+    const int length = static_cast<int>(DecimalDigitCount(decimal.digits));
+    WriteDigitsBackward(decimal.digits, digit_buffer + length);
+    const std::string_view digits(digit_buffer, static_cast<size_t>(length));
+
+    // The decimal point belongs after the first |point| digits, as in
+    // JavaScript’s Number.prototype.toString().
+    const int point = length + decimal.exponent;
+    if (length <= point && point <= 21) {
+      put(digits);
+      put_zeros(point - length);
+    } else if (0 < point && point <= 21) {
+      put(digits.substr(0, static_cast<size_t>(point)));
+      *out++ = '.';
+      put(digits.substr(static_cast<size_t>(point)));
+    } else if (-6 < point && point <= 0) {
+      put("0.");
+      put_zeros(-point);
+      put(digits);
+    } else {
+      put(digits.substr(0, 1));
+      if (length > 1) {
+        *out++ = '.';
+        put(digits.substr(1));
+      }
+      const int exponent = point - 1;
+      put(exponent < 0 ? "e-" : "e+");
+      const uint64_t magnitude = static_cast<uint64_t>(std::abs(exponent));
+      out += DecimalDigitCount(magnitude);
+      WriteDigitsBackward(magnitude, out);
+    }
+  }
+  return static_cast<size_t>(out - output);
+}
+
+template <typename StringT, typename FloatT>
+StringT FloatingPointToString(FloatT value) {
+  typename StringT::value_type buffer[kMaxDoubleStringLength];
+  return StringT(buffer, WriteFloatingPoint(value, buffer));
+}
+
+template <typename FloatT>
+size_t FloatingPointToChars(FloatT value, span<char> output) {
+  if (output.size() >= kMaxDoubleStringLength) {
+    return WriteFloatingPoint(value, output.data());
+  }
+  char buffer[kMaxDoubleStringLength];
+  const size_t length = WriteFloatingPoint(value, buffer);
+  if (length > output.size()) {
+    return 0;
+  }
+  memcpy(output.data(), buffer, length);
+  return length;
+}
+
 template<typename CHAR, int BASE, bool BASE_LTE_10>
 class BaseCharToDigit {
 };
@@ -66,9 +275,201 @@ class WhitespaceHelper<char> {
 
 template<typename CHAR>
 bool LocalIsWhitespace(CHAR c) {
+  // Digits and signs are never whitespace, in any locale, and are by far the
+  // most common first characters.
+  if ((c >= '0' && c <= '9') || c == '-' || c == '+') {
+    return false;
+  }
   return WhitespaceHelper<CHAR>::Invoke(c);
 }
 
+// If the eight characters at |src| are all decimal digits, stores their value
+// in |*value| and returns true. The digits are checked and combined as one
+// 64-bit word, pairwise, rather than one at a time.
+bool EightDigitsToNumber(const char* src, uint32_t* value) {
+  uint64_t chunk;
+  memcpy(&chunk, src, sizeof(chunk));
+#if defined(ARCH_CPU_BIG_ENDIAN)
+  chunk = __builtin_bswap64(chunk);
+#endif
+  // Each byte is a digit if its high nibble is 3, and still is after adding 6.
+  if ((((chunk & 0xF0F0F0F0F0F0F0F0u) |
+        (((chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4))) !=
+      0x3333333333333333u) {
+    return false;
+  }
+  chunk -= 0x3030303030303030u;
+  // Combine adjacent digits into two-digit values in alternate bytes, then
+  // those into the eight-digit value.
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & 0x000000FF000000FFu) * (100 + (1000000ull << 32))) +
+           (((chunk >> 16) & 0x000000FF000000FFu) * (1 + (10000ull << 32)))) >>
+          32;
+  *value = static_cast<uint32_t>(chunk);
+  return true;
+}
+
+bool IsDecimalDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Returns the digits in [|begin|, |end|), which may include a decimal point,
+// times 10^|exponent|, correctly rounded by strtod(). This handles the numbers
+// with too many significant digits for StringToDouble()’s own arithmetic. The
+// point is left out of the copy given to strtod(), which would otherwise
+// expect it to be the locale’s.
+double DigitsToDoubleSlow(const char* begin, const char* end, int exponent) {
+  char stack_buffer[128];
+  std::unique_ptr<char[]> heap_buffer;
+  // The digits, “e”, the exponent with its sign, and a terminator.
+  const size_t buffer_size =
+      static_cast<size_t>(end - begin) + 2 + kMaxIntegerStringLength;
+  char* buffer = stack_buffer;
+  if (buffer_size > sizeof(stack_buffer)) {
+    heap_buffer = std::make_unique<char[]>(buffer_size);
+    buffer = heap_buffer.get();
+  }
+
+  char* out = buffer;
+  bool fraction = false;
+  for (const char* p = begin; p != end; ++p) {
+    if (*p == '.') {
+      fraction = true;
+      continue;
+    }
+    *out++ = *p;
+    if (fraction) {
+      --exponent;
+    }
+  }
+  *out++ = 'e';
+  out += NumberToCharsImpl(Magnitude(exponent), exponent < 0,
+                           span<char>(out, kMaxIntegerStringLength));
+  *out = '\0';
+  return strtod(buffer, nullptr);
+}
+
+constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+// Writes the |size| bytes at |src| to |dest| as 2 × |size| hex digits. Vector
+// paths split sixteen bytes into nibbles at once and interleave them.
+void HexEncodeImpl(const uint8_t* src, size_t size, char* dest) {
+  size_t i = 0;
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+  const __m128i low_nibble = _mm_set1_epi8(0x0F);
+  const auto to_hex = [](__m128i nibbles) {
+    // '0' + nibble, skipping the seven characters between '9' and 'A'.
+    const __m128i letters = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    return _mm_add_epi8(
+        _mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+        _mm_and_si128(letters, _mm_set1_epi8('A' - '9' - 1)));
+  };
+  for (; size - i >= 16; i += 16) {
+    const __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i high =
+        to_hex(_mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble));
+    const __m128i low = to_hex(_mm_and_si128(bytes, low_nibble));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i),
+                     _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i + 16),
+                     _mm_unpackhi_epi8(high, low));
+  }
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+  const uint8x16_t digits =
+      vld1q_u8(reinterpret_cast<const uint8_t*>(kHexDigits));
+  for (; size - i >= 16; i += 16) {
+    const uint8x16_t bytes = vld1q_u8(src + i);
+    uint8x16x2_t chars;
+    chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+    chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0F)));
+    vst2q_u8(reinterpret_cast<uint8_t*>(dest + 2 * i), chars);
+  }
+#endif
+  for (; i < size; ++i) {
+    dest[2 * i] = kHexDigits[src[i] >> 4];
+    dest[2 * i + 1] = kHexDigits[src[i] & 0x0F];
+  }
+}
+
+// Decodes the 2 × |size| hex digits at |src| into |size| bytes at |dest|, and
+// returns how many bytes were decoded before the first invalid digit. Vector
+// paths check and convert 32 digits at once; a block with an invalid digit is
+// left to the scalar loop, which stops at it.
+size_t HexDecodeImpl(const char* src, size_t size, uint8_t* dest) {
+  size_t i = 0;
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+  // Converts each digit to its value, and clears the lane of |*valid| for
+  // each character that isn’t one. Unsigned “x <= max” is min(x, max) == x.
+  const auto to_nibbles = [](__m128i chars, __m128i* valid) {
+    const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i is_digit =
+        _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i letter = _mm_sub_epi8(
+        _mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_letter =
+        _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    *valid = _mm_and_si128(*valid, _mm_or_si128(is_digit, is_letter));
+    return _mm_or_si128(
+        _mm_and_si128(is_digit, digit),
+        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+  };
+  // Each 16-bit lane holds a high nibble in its low byte and a low nibble in
+  // its high byte, and becomes the byte value.
+  const auto to_bytes = [](__m128i nibbles) {
+    return _mm_or_si128(
+        _mm_and_si128(_mm_slli_epi16(nibbles, 4), _mm_set1_epi16(0xF0)),
+        _mm_srli_epi16(nibbles, 8));
+  };
+  for (; size - i >= 16; i += 16) {
+    __m128i valid = _mm_set1_epi8(-1);
+    const __m128i first = to_nibbles(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i)),
+        &valid);
+    const __m128i second = to_nibbles(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i + 16)),
+        &valid);
+    if (_mm_movemask_epi8(valid) != 0xFFFF) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_packus_epi16(to_bytes(first), to_bytes(second)));
+  }
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+  const auto to_nibbles = [](uint8x16_t chars, uint8x16_t* valid) {
+    const uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+    const uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+    const uint8x16_t letter =
+        vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t is_letter = vcltq_u8(letter, vdupq_n_u8(6));
+    *valid = vandq_u8(*valid, vorrq_u8(is_digit, is_letter));
+    return vbslq_u8(is_digit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+  };
+  for (; size - i >= 16; i += 16) {
+    // Loads the digits deinterleaved, high nibbles first.
+    const uint8x16x2_t chars =
+        vld2q_u8(reinterpret_cast<const uint8_t*>(src + 2 * i));
+    uint8x16_t valid = vdupq_n_u8(0xFF);
+    const uint8x16_t high = to_nibbles(chars.val[0], &valid);
+    const uint8x16_t low = to_nibbles(chars.val[1], &valid);
+    if (vminvq_u8(valid) == 0) {
+      break;
+    }
+    vst1q_u8(dest + i, vorrq_u8(vshlq_n_u8(high, 4), low));
+  }
+#endif
+  for (; i < size; ++i) {
+    uint8_t high;
+    uint8_t low;
+    if (!CharToDigit<16>(src[2 * i], &high) ||
+        !CharToDigit<16>(src[2 * i + 1], &low)) {
+      break;
+    }
+    dest[i] = static_cast<uint8_t>((high << 4) | low);
+  }
+  return i;
+}
+
 template<typename IteratorRangeToNumberTraits>
 class IteratorRangeToNumber {
  public:
@@ -119,7 +520,22 @@ class IteratorRangeToNumber {
         begin += 2;
       }
 
-      for (const_iterator current = begin; current != end; ++current) {
+      const_iterator current = begin;
+      if constexpr (traits::kBase == 10) {
+        // Take eight digits at a time for as long as that can't overflow. The
+        // digit-at-a-time loop below finishes the number, and produces the
+        // same partial or saturated output for an invalid one.
+        while (end - current >= 8) {
+          uint32_t digits;
+          if (!EightDigitsToNumber(std::to_address(current), &digits) ||
+              !Sign::AppendEightDigits(digits, output)) {
+            break;
+          }
+          current += 8;
+        }
+      }
+
+      for (; current != end; ++current) {
         uint8_t new_digit = 0;
 
         if (!CharToDigit<traits::kBase>(*current, &new_digit)) {
@@ -153,6 +569,11 @@ class IteratorRangeToNumber {
     static void Increment(uint8_t increment, value_type* output) {
       *output += increment;
     }
+    static bool AppendEightDigits(uint32_t digits, value_type* output) {
+      return (CheckMul(*output, value_type{100000000}) +
+              static_cast<value_type>(digits))
+          .AssignIfValid(output);
+    }
   };
 
   class Negative : public Base<Negative> {
@@ -169,6 +590,11 @@ class IteratorRangeToNumber {
     static void Increment(uint8_t increment, value_type* output) {
       *output -= increment;
     }
+    static bool AppendEightDigits(uint32_t digits, value_type* output) {
+      return (CheckMul(*output, value_type{100000000}) -
+              static_cast<value_type>(digits))
+          .AssignIfValid(output);
+    }
   };
 };
 
@@ -225,6 +651,145 @@ typedef BaseHexIteratorRangeToIntTraits<std::string_view::const_iterator>
 
 }  // namespace
 
+std::string NumberToString(int value) {
+  return IntegerToString<std::string>(value);
+}
+
+std::string NumberToString(unsigned int value) {
+  return IntegerToString<std::string>(value);
+}
+
+std::string NumberToString(long value) {
+  return IntegerToString<std::string>(value);
+}
+
+std::string NumberToString(unsigned long value) {
+  return IntegerToString<std::string>(value);
+}
+
+std::string NumberToString(long long value) {
+  return IntegerToString<std::string>(value);
+}
+
+std::string NumberToString(unsigned long long value) {
+  return IntegerToString<std::string>(value);
+}
+
+std::u16string NumberToString16(int value) {
+  return IntegerToString<std::u16string>(value);
+}
+
+std::u16string NumberToString16(unsigned int value) {
+  return IntegerToString<std::u16string>(value);
+}
+
+std::u16string NumberToString16(long value) {
+  return IntegerToString<std::u16string>(value);
+}
+
+std::u16string NumberToString16(unsigned long value) {
+  return IntegerToString<std::u16string>(value);
+}
+
+std::u16string NumberToString16(long long value) {
+  return IntegerToString<std::u16string>(value);
+}
+
+std::u16string NumberToString16(unsigned long long value) {
+  return IntegerToString<std::u16string>(value);
+}
+
+std::string NumberToString(double value) {
+  return FloatingPointToString<std::string>(value);
+}
+
+std::string NumberToString(float value) {
+  return FloatingPointToString<std::string>(value);
+}
+
+std::u16string NumberToString16(double value) {
+  return FloatingPointToString<std::u16string>(value);
+}
+
+std::u16string NumberToString16(float value) {
+  return FloatingPointToString<std::u16string>(value);
+}
+
+void AppendNumber(std::string* output, double value) {
+  char buffer[kMaxDoubleStringLength];
+  output->append(buffer, WriteFloatingPoint(value, buffer));
+}
+
+void AppendNumber(std::string* output, float value) {
+  char buffer[kMaxDoubleStringLength];
+  output->append(buffer, WriteFloatingPoint(value, buffer));
+}
+
+size_t NumberToChars(double value, span<char> output) {
+  return FloatingPointToChars(value, output);
+}
+
+size_t NumberToChars(float value, span<char> output) {
+  return FloatingPointToChars(value, output);
+}
+
+void AppendNumbers(std::string* output,
+                   span<const double> values,
+                   std::string_view separator) {
+  if (values.empty()) {
+    return;
+  }
+
+  // Make room for the longest possible result, write into it directly, and
+  // trim what wasn’t used.
+  const size_t old_size = output->size();
+  const size_t max_size =
+      (CheckMul(values.size(), kMaxDoubleStringLength + separator.size()) +
+       old_size)
+          .ValueOrDie();
+  internal::Resize(*output, max_size, internal::priority_tag<1>());
+  char* const begin = output->data() + old_size;
+  char* out = begin;
+  bool first = true;
+  for (double value : values) {
+    if (!first) {
+      memcpy(out, separator.data(), separator.size());
+      out += separator.size();
+    }
+    first = false;
+    out += WriteFloatingPoint(value, out);
+  }
+  output->resize(old_size + static_cast<size_t>(out - begin));
+}
+
+std::string HexEncode(span<const uint8_t> input) {
+  std::string result;
+  internal::Resize(result, CheckMul(input.size(), 2).ValueOrDie(),
+                   internal::priority_tag<1>());
+  HexEncodeImpl(input.data(), input.size(), result.data());
+  return result;
+}
+
+namespace internal {
+
+void AppendSignedNumber(int64_t value, std::string* output) {
+  AppendNumberImpl(Magnitude(value), value < 0, output);
+}
+
+void AppendUnsignedNumber(uint64_t value, std::string* output) {
+  AppendNumberImpl(value, false, output);
+}
+
+size_t SignedNumberToChars(int64_t value, span<char> output) {
+  return NumberToCharsImpl(Magnitude(value), value < 0, output);
+}
+
+size_t UnsignedNumberToChars(uint64_t value, span<char> output) {
+  return NumberToCharsImpl(value, false, output);
+}
+
+}  // namespace internal
+
 bool StringToInt(std::string_view input, int* output) {
   return IteratorRangeToNumber<IteratorRangeToIntTraits>::Invoke(input.begin(),
                                                                  input.end(),
@@ -252,26 +817,151 @@ bool StringToSizeT(std::string_view input, size_t* output) {
       input.begin(), input.end(), output);
 }
 
+bool StringToDouble(std::string_view input, double* output) {
+  const char* p = input.data();
+  const char* const end = p + input.size();
+  bool valid = true;
+  while (p != end && LocalIsWhitespace(*p)) {
+    valid = false;
+    ++p;
+  }
+  bool negative = false;
+  if (p != end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    ++p;
+  }
+
+  // The value is |digits| × 10^|exponent|. Up to 19 significant digits, which
+  // always fit, are kept in |digits|; |inexact| notes whether any non-zero
+  // digit past those was dropped.
+  const char* const digits_begin = p;
+  uint64_t digits = 0;
+  int digit_count = 0;
+  int exponent = 0;
+  bool inexact = false;
+  bool any_digits = false;
+  for (bool fraction = false;; ++p) {
+    uint32_t chunk;
+    while (digits != 0 && digit_count <= 19 - 8 && end - p >= 8 &&
+           EightDigitsToNumber(p, &chunk)) {
+      digits = digits * 100000000 + chunk;
+      digit_count += 8;
+      exponent -= fraction ? 8 : 0;
+      p += 8;
+    }
+    if (p == end) {
+      break;
+    }
+    if (*p == '.' && !fraction) {
+      fraction = true;
+      continue;
+    }
+    if (!IsDecimalDigit(*p)) {
+      break;
+    }
+    any_digits = true;
+    const int digit = *p - '0';
+    if (digits == 0 && digit == 0) {
+      exponent -= fraction ? 1 : 0;
+    } else if (digit_count < 19) {
+      digits = digits * 10 + static_cast<uint64_t>(digit);
+      ++digit_count;
+      exponent -= fraction ? 1 : 0;
+    } else {
+      exponent += fraction ? 0 : 1;
+      inexact |= digit != 0;
+    }
+  }
+  if (!any_digits) {
+    *output = 0;
+    return false;
+  }
+  const char* const digits_end = p;
+
+  int explicit_exponent = 0;
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    const char* q = p + 1;
+    bool exponent_negative = false;
+    if (q != end && (*q == '-' || *q == '+')) {
+      exponent_negative = *q == '-';
+      ++q;
+    }
+    if (q != end && IsDecimalDigit(*q)) {
+      // Anything past this limit is infinity or 0 anyway.
+      for (; q != end && IsDecimalDigit(*q); ++q) {
+        if (explicit_exponent < 100000) {
+          explicit_exponent = explicit_exponent * 10 + (*q - '0');
+        }
+      }
+      if (exponent_negative) {
+        explicit_exponent = -explicit_exponent;
+      }
+      p = q;
+    }
+  }
+  exponent += explicit_exponent;
+  if (p != end) {
+    valid = false;
+  }
+
+  // Every integer up to 2^53 and power of 10 up to 10^22 is exactly a double,
+  // so a single multiplication or division of them is correctly rounded.
+  static constexpr double kExactPowersOf10[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  constexpr uint64_t kMaxShortDigits = 100000000000000000u;
+  if (!inexact && digits >= kMaxShortDigits) {
+    while (digits % 10 == 0) {
+      digits /= 10;
+      ++exponent;
+    }
+  }
+  double value;
+  if (inexact || digits >= kMaxShortDigits) {
+    value = DigitsToDoubleSlow(digits_begin, digits_end, explicit_exponent);
+  } else if (digits <= (uint64_t{1} << 53) && exponent >= -22 &&
+             exponent <= 22) {
+    value = static_cast<double>(digits);
+    if (exponent < 0) {
+      value /= kExactPowersOf10[-exponent];
+    } else {
+      value *= kExactPowersOf10[exponent];
+    }
+  } else {
+    value = internal::DecimalToDouble(digits, exponent);
+  }
+
+  if (std::isinf(value)) {
+    valid = false;
+  }
+  *output = negative ? -value : value;
+  return valid;
+}
+
 bool HexStringToInt(std::string_view input, int* output) {
   return IteratorRangeToNumber<HexIteratorRangeToIntTraits>::Invoke(
       input.begin(), input.end(), output);
 }
 
 bool HexStringToBytes(const std::string& input, std::vector<uint8_t>* output) {
-  size_t count = input.size();
+  const size_t count = input.size();
   if (count == 0 || (count % 2) != 0) {
     return false;
   }
-  for (size_t i = 0; i < count; i += 2) {
-    uint8_t msb = 0;
-    uint8_t lsb = 0;
-    if (!CharToDigit<16>(input[i], &msb) ||
-        !CharToDigit<16>(input[i + 1], &lsb)) {
-      return false;
-    }
-    output->push_back(static_cast<uint8_t>((msb << 4) | lsb));
+  const size_t old_size = output->size();
+  output->resize(old_size + count / 2);
+  const size_t decoded =
+      HexDecodeImpl(input.data(), count / 2, output->data() + old_size);
+  output->resize(old_size + decoded);
+  return decoded == count / 2;
+}
+
+bool HexDecode(std::string_view input, span<uint8_t> output) {
+  if ((input.size() % 2) != 0 || input.size() / 2 != output.size()) {
+    return false;
   }
-  return true;
+  return HexDecodeImpl(input.data(), output.size(), output.data()) ==
+         output.size();
 }
 
 }  // namespace base
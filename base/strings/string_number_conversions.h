@@ -5,23 +5,126 @@
 #ifndef MINI_CHROMIUM_BASE_STRINGS_STRING_NUMBER_CONVERSIONS_H_
 #define MINI_CHROMIUM_BASE_STRINGS_STRING_NUMBER_CONVERSIONS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <concepts>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "base/containers/span.h"
+
 namespace base {
 
+// Number -> string conversions -----------------------------------------------
+
+// These produce the same text as printf()’s %d and %u, without parsing a format
+// string or consulting the locale.
+std::string NumberToString(int value);
+std::string NumberToString(unsigned int value);
+std::string NumberToString(long value);
+std::string NumberToString(unsigned long value);
+std::string NumberToString(long long value);
+std::string NumberToString(unsigned long long value);
+
+std::u16string NumberToString16(int value);
+std::u16string NumberToString16(unsigned int value);
+std::u16string NumberToString16(long value);
+std::u16string NumberToString16(unsigned long value);
+std::u16string NumberToString16(long long value);
+std::u16string NumberToString16(unsigned long long value);
+
+// The length of the longest decimal representation of an integer of up to 64
+// bits, including its sign.
+inline constexpr size_t kMaxIntegerStringLength = 20;
+
+namespace internal {
+void AppendSignedNumber(int64_t value, std::string* output);
+void AppendUnsignedNumber(uint64_t value, std::string* output);
+size_t SignedNumberToChars(int64_t value, span<char> output);
+size_t UnsignedNumberToChars(uint64_t value, span<char> output);
+}  // namespace internal
+
+// Appends the decimal representation of |value| to |*output|.
+template <typename T>
+  requires(std::integral<T> && !std::same_as<T, bool>)
+void AppendNumber(std::string* output, T value) {
+  if constexpr (std::signed_integral<T>) {
+    internal::AppendSignedNumber(value, output);
+  } else {
+    internal::AppendUnsignedNumber(value, output);
+  }
+}
+
+// Writes the decimal representation of |value| to the start of |output|, and
+// returns its length. If |output| is too short, which it never is with room
+// for kMaxIntegerStringLength characters, writes nothing and returns 0.
+template <typename T>
+  requires(std::integral<T> && !std::same_as<T, bool>)
+size_t NumberToChars(T value, span<char> output) {
+  if constexpr (std::signed_integral<T>) {
+    return internal::SignedNumberToChars(value, output);
+  } else {
+    return internal::UnsignedNumberToChars(value, output);
+  }
+}
+
+// These produce the shortest text that converts back to the same |value|,
+// formatted as JavaScript formats numbers: “0.1”, “1500”, “1e+21”, “1.5e-7”,
+// “-0”, “NaN” and “Infinity”. They do not consult the locale.
+std::string NumberToString(double value);
+std::string NumberToString(float value);
+
+std::u16string NumberToString16(double value);
+std::u16string NumberToString16(float value);
+
+// The length of the longest text produced for a double or float, such as
+// “-2.2250738585072014e-308”.
+inline constexpr size_t kMaxDoubleStringLength = 25;
+
+// Like the integer versions above, but formatted as by NumberToString(double).
+void AppendNumber(std::string* output, double value);
+void AppendNumber(std::string* output, float value);
+size_t NumberToChars(double value, span<char> output);
+size_t NumberToChars(float value, span<char> output);
+
+// Appends each of |values|, formatted as by NumberToString(double), to
+// |*output|, with |separator| between them. |*output| grows at most once.
+void AppendNumbers(std::string* output,
+                   span<const double> values,
+                   std::string_view separator);
+
+// Returns |input| as uppercase hex digits, two per byte.
+std::string HexEncode(span<const uint8_t> input);
+
+// String -> number conversions -----------------------------------------------
+
 bool StringToInt(std::string_view input, int* output);
 bool StringToUint(std::string_view input, unsigned int* output);
 bool StringToInt64(std::string_view input, int64_t* output);
 bool StringToUint64(std::string_view input, uint64_t* output);
 bool StringToSizeT(std::string_view input, size_t* output);
 
+// Parses a decimal number such as “1.5”, “-.5e10” or “3”, rounding it
+// correctly. Leading whitespace, trailing characters, an empty |input| and a
+// value too large for a double all fail, although |*output| is still set to the
+// best value found. Hexadecimal, “Infinity” and “NaN” are not accepted. The
+// locale is not consulted.
+bool StringToDouble(std::string_view input, double* output);
+
 bool HexStringToInt(std::string_view input, int* output);
+
+// Appends the bytes encoded by |input|, a non-empty, even-length string of hex
+// digits in either case, to |*output|. If a digit is invalid, returns false
+// after appending the bytes before it.
 bool HexStringToBytes(const std::string& input, std::vector<uint8_t>* output);
 
+// Decodes |input|, hex digits in either case, into |output|, which must be
+// exactly half as long. Returns false if it isn’t or a digit is invalid, in
+// which case the contents of |output| are unspecified.
+bool HexDecode(std::string_view input, span<uint8_t> output);
+
 }  // namespace base
 
 #endif  // MINI_CHROMIUM_BASE_STRINGS_STRING_NUMBER_CONVERSIONS_H_
@@ -0,0 +1,248 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/string_number_conversions.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace {
+
+// The values converted by each measured batch.
+constexpr size_t kValues = 1024;
+
+// A fixed xorshift sequence, so that every run converts the same values.
+class Random {
+ public:
+  uint64_t Next() {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 7;
+    state_ ^= state_ << 17;
+    return state_;
+  }
+
+ private:
+  uint64_t state_ = 0x2545f4914f6cdd1d;
+};
+
+// Integers of every length, from one digit to twenty.
+std::vector<int64_t> MakeIntegers() {
+  Random random;
+  std::vector<int64_t> values(kValues);
+  for (int64_t& value : values) {
+    const uint64_t bits = random.Next();
+    value = static_cast<int64_t>(bits >> (bits % 64));
+  }
+  return values;
+}
+
+// Doubles of every magnitude, and some with few digits, like most in practice.
+std::vector<double> MakeDoubles() {
+  Random random;
+  std::vector<double> values(kValues);
+  for (size_t index = 0; index < kValues; ++index) {
+    const uint64_t bits = random.Next();
+    if (index % 2) {
+      values[index] = static_cast<double>(bits % 100000) / 100;
+    } else {
+      values[index] = static_cast<double>(bits >> 11) *
+                      (static_cast<double>(1 + bits % 64) / (1 << 20));
+    }
+  }
+  return values;
+}
+
+// Reports the time per value taken by |convert| over a batch of kValues.
+template <typename Convert>
+void ReportNanosecondsPerValue(const char* metric,
+                               const char* story,
+                               Convert convert) {
+  const double ns = perf_test::MeasureNanosecondsPerCall(convert);
+  perf_test::PrintResult(metric, story, ns / kValues, "ns_per_value");
+}
+
+std::string ReferenceHexEncode(span<const uint8_t> input) {
+  static constexpr char kDigits[] = "0123456789ABCDEF";
+  std::string hex;
+  for (const uint8_t byte : input) {
+    hex.push_back(kDigits[byte >> 4]);
+    hex.push_back(kDigits[byte & 0xf]);
+  }
+  return hex;
+}
+
+int ReferenceHexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+bool ReferenceHexDecode(std::string_view input, std::vector<uint8_t>* output) {
+  for (size_t index = 0; index + 1 < input.size(); index += 2) {
+    const int high = ReferenceHexDigit(input[index]);
+    const int low = ReferenceHexDigit(input[index + 1]);
+    if (high < 0 || low < 0) {
+      return false;
+    }
+    output->push_back(static_cast<uint8_t>(high << 4 | low));
+  }
+  return true;
+}
+
+}  // namespace
+
+PERF_TEST(StringNumberConversions, IntegerToString) {
+  const std::vector<int64_t> values = MakeIntegers();
+
+  ReportNanosecondsPerValue("integer_to_string", "number_to_string", [&] {
+    for (const int64_t value : values) {
+      perf_test::DoNotOptimize(NumberToString(value));
+    }
+  });
+  ReportNanosecondsPerValue("integer_to_string", "append_number", [&] {
+    std::string output;
+    for (const int64_t value : values) {
+      output.clear();
+      AppendNumber(&output, value);
+      perf_test::DoNotOptimize(output);
+    }
+  });
+  ReportNanosecondsPerValue("integer_to_string", "number_to_chars", [&] {
+    char buffer[kMaxIntegerStringLength];
+    for (const int64_t value : values) {
+      perf_test::DoNotOptimize(NumberToChars(value, buffer));
+    }
+  });
+  ReportNanosecondsPerValue("integer_to_string", "snprintf", [&] {
+    char buffer[kMaxIntegerStringLength + 1];
+    for (const int64_t value : values) {
+      perf_test::DoNotOptimize(
+          snprintf(buffer, sizeof(buffer), "%" PRId64, value));
+    }
+  });
+}
+
+PERF_TEST(StringNumberConversions, StringToInteger) {
+  std::vector<std::string> strings;
+  for (const int64_t value : MakeIntegers()) {
+    strings.push_back(std::to_string(value));
+  }
+
+  ReportNanosecondsPerValue("string_to_integer", "string_to_int64", [&] {
+    for (const std::string& string : strings) {
+      int64_t value;
+      perf_test::DoNotOptimize(StringToInt64(string, &value));
+      perf_test::DoNotOptimize(value);
+    }
+  });
+  ReportNanosecondsPerValue("string_to_integer", "strtoll", [&] {
+    for (const std::string& string : strings) {
+      perf_test::DoNotOptimize(strtoll(string.c_str(), nullptr, 10));
+    }
+  });
+}
+
+PERF_TEST(StringNumberConversions, DoubleToString) {
+  const std::vector<double> values = MakeDoubles();
+
+  ReportNanosecondsPerValue("double_to_string", "number_to_string", [&] {
+    for (const double value : values) {
+      perf_test::DoNotOptimize(NumberToString(value));
+    }
+  });
+  ReportNanosecondsPerValue("double_to_string", "number_to_chars", [&] {
+    char buffer[32];
+    for (const double value : values) {
+      perf_test::DoNotOptimize(NumberToChars(value, buffer));
+    }
+  });
+  ReportNanosecondsPerValue("double_to_string", "append_numbers", [&] {
+    std::string output;
+    AppendNumbers(&output, values, ",");
+    perf_test::DoNotOptimize(output);
+  });
+  ReportNanosecondsPerValue("double_to_string", "snprintf_17g", [&] {
+    char buffer[32];
+    for (const double value : values) {
+      perf_test::DoNotOptimize(
+          snprintf(buffer, sizeof(buffer), "%.17g", value));
+    }
+  });
+}
+
+PERF_TEST(StringNumberConversions, StringToDouble) {
+  std::vector<std::string> strings;
+  for (const double value : MakeDoubles()) {
+    strings.push_back(NumberToString(value));
+  }
+
+  ReportNanosecondsPerValue("string_to_double", "string_to_double", [&] {
+    for (const std::string& string : strings) {
+      double value;
+      perf_test::DoNotOptimize(StringToDouble(string, &value));
+      perf_test::DoNotOptimize(value);
+    }
+  });
+  ReportNanosecondsPerValue("string_to_double", "strtod", [&] {
+    for (const std::string& string : strings) {
+      perf_test::DoNotOptimize(strtod(string.c_str(), nullptr));
+    }
+  });
+}
+
+PERF_TEST(StringNumberConversions, Hex) {
+  constexpr size_t kBytes = 64 * 1024;
+  Random random;
+  std::vector<uint8_t> bytes(kBytes);
+  for (uint8_t& byte : bytes) {
+    byte = static_cast<uint8_t>(random.Next());
+  }
+  const std::string hex = HexEncode(bytes);
+
+  const auto report = [&](const char* metric, const char* story, auto body) {
+    const double ns = perf_test::MeasureNanosecondsPerCall(body);
+    perf_test::PrintResult(
+        metric, story, static_cast<double>(kBytes) / ns, "GB_per_s");
+  };
+
+  report("hex_encode", "hex_encode", [&] {
+    perf_test::DoNotOptimize(HexEncode(bytes));
+  });
+  report("hex_encode", "reference", [&] {
+    perf_test::DoNotOptimize(ReferenceHexEncode(bytes));
+  });
+
+  std::vector<uint8_t> decoded(kBytes);
+  report("hex_decode", "hex_decode", [&] {
+    perf_test::DoNotOptimize(HexDecode(hex, decoded));
+    perf_test::DoNotOptimize(decoded.data());
+  });
+  report("hex_decode", "hex_string_to_bytes", [&] {
+    decoded.clear();
+    perf_test::DoNotOptimize(HexStringToBytes(hex, &decoded));
+  });
+  report("hex_decode", "reference", [&] {
+    decoded.clear();
+    perf_test::DoNotOptimize(ReferenceHexDecode(hex, &decoded));
+  });
+}
+
+}  // namespace base
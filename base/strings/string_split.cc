@@ -0,0 +1,166 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/string_split.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <bit>
+
+#include "base/check.h"
+#include "base/strings/string_util.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace base {
+
+namespace {
+
+// The most separators that FindFirstOf() compares a whole vector against.
+constexpr size_t kMaxVectorSeparators = 4;
+
+void AppendPiece(std::string_view piece,
+                 WhitespaceHandling whitespace,
+                 SplitResult result_type,
+                 std::vector<std::string_view>* result) {
+  if (whitespace == TRIM_WHITESPACE) {
+    piece = TrimWhitespaceASCII(piece, TRIM_ALL);
+  }
+  if (result_type == SPLIT_WANT_ALL || !piece.empty()) {
+    result->push_back(piece);
+  }
+}
+
+}  // namespace
+
+namespace internal {
+
+const char* FindFirstOf(const char* begin,
+                        const char* end,
+                        std::string_view separators) {
+  const size_t count = separators.size();
+  if (count == 0) {
+    return end;
+  }
+
+  const char* s = begin;
+  if (count <= kMaxVectorSeparators) {
+    // With fewer than four separators, some are compared twice.
+    const char separator0 = separators[0];
+    const char separator1 = separators[count > 1 ? 1 : 0];
+    const char separator2 = separators[count > 2 ? 2 : 0];
+    const char separator3 = separators[count - 1];
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+    const __m128i s0 = _mm_set1_epi8(separator0);
+    const __m128i s1 = _mm_set1_epi8(separator1);
+    const __m128i s2 = _mm_set1_epi8(separator2);
+    const __m128i s3 = _mm_set1_epi8(separator3);
+    for (; end - s >= 16; s += 16) {
+      const __m128i bytes =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+      const __m128i matches =
+          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, s0),
+                                    _mm_cmpeq_epi8(bytes, s1)),
+                       _mm_or_si128(_mm_cmpeq_epi8(bytes, s2),
+                                    _mm_cmpeq_epi8(bytes, s3)));
+      const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+      if (mask != 0) {
+        return s + std::countr_zero(mask);
+      }
+    }
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+    const uint8x16_t s0 = vdupq_n_u8(static_cast<uint8_t>(separator0));
+    const uint8x16_t s1 = vdupq_n_u8(static_cast<uint8_t>(separator1));
+    const uint8x16_t s2 = vdupq_n_u8(static_cast<uint8_t>(separator2));
+    const uint8x16_t s3 = vdupq_n_u8(static_cast<uint8_t>(separator3));
+    for (; end - s >= 16; s += 16) {
+      const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(s));
+      const uint8x16_t matches =
+          vorrq_u8(vorrq_u8(vceqq_u8(bytes, s0), vceqq_u8(bytes, s1)),
+                   vorrq_u8(vceqq_u8(bytes, s2), vceqq_u8(bytes, s3)));
+      // Narrows each byte of |matches| to four bits.
+      const uint64_t mask = vget_lane_u64(
+          vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)),
+          0);
+      if (mask != 0) {
+        return s + std::countr_zero(mask) / 4;
+      }
+    }
+#endif
+    for (; s != end; ++s) {
+      const char c = *s;
+      if (c == separator0 || c == separator1 || c == separator2 ||
+          c == separator3) {
+        return s;
+      }
+    }
+    return end;
+  }
+
+  uint64_t is_separator[4] = {};
+  for (const char c : separators) {
+    const uint8_t byte = static_cast<uint8_t>(c);
+    is_separator[byte / 64] |= uint64_t{1} << (byte % 64);
+  }
+  for (; s != end; ++s) {
+    const uint8_t byte = static_cast<uint8_t>(*s);
+    if ((is_separator[byte / 64] >> (byte % 64)) & 1) {
+      return s;
+    }
+  }
+  return end;
+}
+
+}  // namespace internal
+
+std::vector<std::string_view> SplitStringPiece(std::string_view input,
+                                               std::string_view separators,
+                                               WhitespaceHandling whitespace,
+                                               SplitResult result_type) {
+  std::vector<std::string_view> result;
+  if (input.empty()) {
+    return result;
+  }
+
+  const char* const end = input.data() + input.size();
+  for (const char* begin = input.data();; ++begin) {
+    const char* const separator = internal::FindFirstOf(begin, end, separators);
+    AppendPiece(std::string_view(begin, static_cast<size_t>(separator - begin)),
+                whitespace, result_type, &result);
+    if (separator == end) {
+      return result;
+    }
+    begin = separator;
+  }
+}
+
+std::vector<std::string_view> SplitStringPieceUsingSubstr(
+    std::string_view input,
+    std::string_view delimiter,
+    WhitespaceHandling whitespace,
+    SplitResult result_type) {
+  CHECK(!delimiter.empty());
+  std::vector<std::string_view> result;
+  if (input.empty()) {
+    return result;
+  }
+
+  for (size_t begin = 0;;) {
+    const size_t found = input.find(delimiter, begin);
+    AppendPiece(input.substr(begin, found - begin), whitespace, result_type,
+                &result);
+    if (found == std::string_view::npos) {
+      return result;
+    }
+    begin = found + delimiter.size();
+  }
+}
+
+}  // namespace base
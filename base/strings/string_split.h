@@ -0,0 +1,61 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_STRINGS_STRING_SPLIT_H_
+#define MINI_CHROMIUM_BASE_STRINGS_STRING_SPLIT_H_
+
+#include <string_view>
+#include <vector>
+
+namespace base {
+
+enum WhitespaceHandling {
+  KEEP_WHITESPACE,
+  TRIM_WHITESPACE,
+};
+
+enum SplitResult {
+  // Every piece is returned, including empty ones: splitting ",a,,b," on ','
+  // yields "", "a", "", "b" and "".
+  SPLIT_WANT_ALL,
+
+  // Only non-empty pieces are returned, after any trimming: splitting
+  // ",a, ,b," on ',' with TRIM_WHITESPACE yields "a" and "b".
+  SPLIT_WANT_NONEMPTY,
+};
+
+// Splits |input| at every byte that is one of |separators|, and returns the
+// pieces as views into |input|, so only the vector is allocated. An empty
+// |input| has no pieces. With TRIM_WHITESPACE, ASCII whitespace is trimmed
+// from both ends of each piece.
+//
+// Separators are found a vector at a time when there are at most four of
+// them, as in a comma- or whitespace-separated list.
+[[nodiscard]] std::vector<std::string_view> SplitStringPiece(
+    std::string_view input,
+    std::string_view separators,
+    WhitespaceHandling whitespace,
+    SplitResult result_type);
+
+// Like SplitStringPiece(), but splits at every occurrence of the whole of
+// |delimiter|, which must not be empty.
+[[nodiscard]] std::vector<std::string_view> SplitStringPieceUsingSubstr(
+    std::string_view input,
+    std::string_view delimiter,
+    WhitespaceHandling whitespace,
+    SplitResult result_type);
+
+namespace internal {
+
+// Returns the first byte of [begin, end) that is one of |separators|, or
+// |end| if there is none.
+const char* FindFirstOf(const char* begin,
+                        const char* end,
+                        std::string_view separators);
+
+}  // namespace internal
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_STRINGS_STRING_SPLIT_H_
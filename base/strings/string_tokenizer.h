@@ -0,0 +1,110 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_STRINGS_STRING_TOKENIZER_H_
+#define MINI_CHROMIUM_BASE_STRINGS_STRING_TOKENIZER_H_
+
+#include <stddef.h>
+
+#include <iterator>
+#include <string_view>
+
+#include "base/strings/string_split.h"
+
+namespace base {
+
+// Splits a string into tokens, the non-empty runs of bytes between bytes that
+// are one of |delimiters|, one token at a time and without copying. Each token
+// is a view into the input, which must outlive the tokenizer:
+//
+//   StringViewTokenizer t(line, ", ");
+//   while (t.GetNext()) {
+//     Use(t.token());
+//   }
+//
+// or:
+//
+//   for (std::string_view token : StringViewTokenizer(line, ", ")) {
+//     Use(token);
+//   }
+//
+// Unlike SplitStringPiece(), nothing is allocated, and a caller that stops
+// early never looks at the rest of the input.
+class StringViewTokenizer {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = std::string_view;
+
+    Iterator() = default;
+
+    std::string_view operator*() const { return tokenizer_->token(); }
+
+    Iterator& operator++() {
+      if (!tokenizer_->GetNext()) {
+        tokenizer_ = nullptr;
+      }
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const Iterator&, const Iterator&) = default;
+
+   private:
+    friend class StringViewTokenizer;
+
+    explicit Iterator(StringViewTokenizer* tokenizer) : tokenizer_(tokenizer) {}
+
+    // Null at the end.
+    StringViewTokenizer* tokenizer_ = nullptr;
+  };
+
+  StringViewTokenizer(std::string_view input, std::string_view delimiters)
+      : next_(input.data()),
+        end_(input.data() + input.size()),
+        delimiters_(delimiters) {}
+
+  StringViewTokenizer(const StringViewTokenizer&) = delete;
+  StringViewTokenizer& operator=(const StringViewTokenizer&) = delete;
+
+  // Advances to the next token, returning false if there are no more.
+  bool GetNext() {
+    while (next_ != end_ &&
+           delimiters_.find(*next_) != std::string_view::npos) {
+      ++next_;
+    }
+    if (next_ == end_) {
+      token_ = std::string_view();
+      return false;
+    }
+    const char* const token_end =
+        internal::FindFirstOf(next_, end_, delimiters_);
+    token_ = std::string_view(next_, static_cast<size_t>(token_end - next_));
+    next_ = token_end;
+    return true;
+  }
+
+  // The current token, valid after GetNext() returns true.
+  std::string_view token() const { return token_; }
+
+  // Iterates over the tokens from the current position. Like GetNext(), this
+  // consumes the tokenizer.
+  Iterator begin() { return Iterator(GetNext() ? this : nullptr); }
+  Iterator end() { return Iterator(); }
+
+ private:
+  const char* next_;
+  const char* const end_;
+  const std::string_view delimiters_;
+  std::string_view token_;
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_STRINGS_STRING_TOKENIZER_H_
@@ -5,6 +5,8 @@
 #ifndef MINI_CHROMIUM_BASE_STRINGS_STRING_UTIL_H_
 #define MINI_CHROMIUM_BASE_STRINGS_STRING_UTIL_H_
 
+#include <string_view>
+
 #include "base/check_op.h"
 #include "base/compiler_specific.h"
 #include "build/build_config.h"
@@ -28,6 +30,32 @@ inline bool IsAsciiDigit(Char c) {
   return c >= '0' && c <= '9';
 }
 
+enum TrimPositions {
+  TRIM_NONE = 0,
+  TRIM_LEADING = 1 << 0,
+  TRIM_TRAILING = 1 << 1,
+  TRIM_ALL = TRIM_LEADING | TRIM_TRAILING,
+};
+
+// Returns the part of |input| without the ASCII whitespace at the ends given
+// by |positions|. Nothing is copied.
+inline std::string_view TrimWhitespaceASCII(std::string_view input,
+                                            TrimPositions positions) {
+  const char* begin = input.data();
+  const char* end = begin + input.size();
+  if (positions & TRIM_LEADING) {
+    while (begin != end && IsAsciiWhitespace(*begin)) {
+      ++begin;
+    }
+  }
+  if (positions & TRIM_TRAILING) {
+    while (end != begin && IsAsciiWhitespace(end[-1])) {
+      --end;
+    }
+  }
+  return std::string_view(begin, static_cast<size_t>(end - begin));
+}
+
 template <class string_type>
 inline typename string_type::value_type* WriteInto(string_type* str,
                                                    size_t length_with_null) {
@@ -91,17 +91,19 @@ static void StringAppendVT(StringType* dst,
 
 }  // namespace
 
-std::string StringPrintf(const char* format, ...) {
+void StringAppendV(std::string* dst, const char* format, va_list ap) {
+  StringAppendVT(dst, format, ap);
+}
+
+namespace internal {
+
+void StringAppendFUnchecked(std::string* dst, const char* format, ...) {
   va_list ap;
   va_start(ap, format);
-  std::string result;
-  StringAppendV(&result, format, ap);
+  StringAppendV(dst, format, ap);
   va_end(ap);
-  return result;
 }
 
-void StringAppendV(std::string* dst, const char* format, va_list ap) {
-  StringAppendVT(dst, format, ap);
-}
+}  // namespace internal
 
 }  // namespace base
@@ -8,13 +8,64 @@
 #include <stdarg.h>
 
 #include <string>
+#include <type_traits>
 
 #include "base/compiler_specific.h"
+#include "base/strings/str_format.h"
 
 namespace base {
 
-std::string StringPrintf(const char* format, ...)
-    PRINTF_FORMAT(1, 2);
+// With a string literal for the format, these format with StrFormat(), so the
+// format is checked against the arguments at compile time, and the output is
+// formatted only once.
+//
+// A format that is not a literal, such as a const char* chosen at run time,
+// is instead passed to vsnprintf() with the arguments, unchecked, as these
+// always did before. Arguments must then be types that vsnprintf() accepts.
+template <typename... Args>
+[[nodiscard]] std::string StringPrintf(
+    const FormatString<std::type_identity_t<Args>...>& format,
+    const Args&... args) {
+  return StrFormat(format, args...);
+}
+
+template <typename... Args>
+void StringAppendF(std::string* dst,
+                   const FormatString<std::type_identity_t<Args>...>& format,
+                   const Args&... args) {
+  StrAppendFormat(dst, format, args...);
+}
+
+namespace internal {
+
+// Any format but a literal, which is an array.
+template <typename Format>
+concept RuntimeFormatString =
+    std::is_convertible_v<const Format&, const char*> &&
+    !std::is_array_v<Format>;
+
+// Appends with vsnprintf().
+void StringAppendFUnchecked(std::string* dst, const char* format, ...);
+
+}  // namespace internal
+
+template <internal::RuntimeFormatString Format, typename... Args>
+[[nodiscard]] std::string StringPrintf(const Format& format,
+                                       const Args&... args) {
+  std::string result;
+  internal::StringAppendFUnchecked(&result, format, args...);
+  return result;
+}
+
+template <internal::RuntimeFormatString Format, typename... Args>
+void StringAppendF(std::string* dst,
+                   const Format& format,
+                   const Args&... args) {
+  internal::StringAppendFUnchecked(dst, format, args...);
+}
+
+// Appends with vsnprintf(), for a va_list that can’t be checked at compile
+// time.
 void StringAppendV(std::string* dst, const char* format, va_list ap)
     PRINTF_FORMAT(2, 0);
 
@@ -0,0 +1,98 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/stringprintf.h"
+
+#include <stdio.h>
+
+#include <string>
+
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace {
+
+struct Format {
+  const char* story;
+  const char* format;
+};
+
+void Report(const char* story, const char* variant, double ns) {
+  perf_test::PrintResult(
+      "string_printf", std::string(story) + "_" + variant, ns, "ns");
+}
+
+}  // namespace
+
+// Each format is measured three ways: as a literal, checked at compile time and
+// formatted by StrFormat(); as a const char*, formatted by vsnprintf(); and
+// with snprintf() into a stack buffer, which allocates nothing.
+PERF_TEST(StringPrintf, Formats) {
+  int integer = 123456789;
+  double number = 3.14159;
+  const char* string = "a short string";
+  perf_test::DoNotOptimize(integer);
+  perf_test::DoNotOptimize(number);
+  perf_test::DoNotOptimize(string);
+
+  const auto measure = [](auto body) {
+    return perf_test::MeasureNanosecondsPerCall(body);
+  };
+
+  {
+    const char* format = "%d";
+    perf_test::DoNotOptimize(format);
+    Report("integer", "literal", measure([&] {
+             perf_test::DoNotOptimize(StringPrintf("%d", integer));
+           }));
+    Report("integer", "runtime", measure([&] {
+             perf_test::DoNotOptimize(StringPrintf(format, integer));
+           }));
+    Report("integer", "snprintf", measure([&] {
+             char buffer[64];
+             perf_test::DoNotOptimize(
+                 snprintf(buffer, sizeof(buffer), "%d", integer));
+           }));
+  }
+
+  {
+    const char* format = "%s: %d (%.2f)";
+    perf_test::DoNotOptimize(format);
+    Report("mixed", "literal", measure([&] {
+             perf_test::DoNotOptimize(
+                 StringPrintf("%s: %d (%.2f)", string, integer, number));
+           }));
+    Report("mixed", "runtime", measure([&] {
+             perf_test::DoNotOptimize(
+                 StringPrintf(format, string, integer, number));
+           }));
+    Report("mixed", "snprintf", measure([&] {
+             char buffer[64];
+             perf_test::DoNotOptimize(snprintf(
+                 buffer, sizeof(buffer), "%s: %d (%.2f)", string, integer,
+                 number));
+           }));
+  }
+
+  {
+    const char* format = "%08x-%04x";
+    perf_test::DoNotOptimize(format);
+    Report("hex", "literal", measure([&] {
+             perf_test::DoNotOptimize(
+                 StringPrintf("%08x-%04x", integer, integer & 0xffff));
+           }));
+    Report("hex", "runtime", measure([&] {
+             perf_test::DoNotOptimize(
+                 StringPrintf(format, integer, integer & 0xffff));
+           }));
+    Report("hex", "snprintf", measure([&] {
+             char buffer[64];
+             perf_test::DoNotOptimize(snprintf(
+                 buffer, sizeof(buffer), "%08x-%04x", integer,
+                 integer & 0xffff));
+           }));
+  }
+}
+
+}  // namespace base
@@ -5,32 +5,401 @@
 #include "base/strings/utf_string_conversions.h"
 
 #include <stdint.h>
+#include <string.h>
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <string_view>
 
+#include "base/strings/strcat_internal.h"
 #include "base/strings/utf_string_conversion_utils.h"
+#include "base/third_party/icu/icu_utf.h"
 #include "build/build_config.h"
 
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace {
 
-template<typename SRC_CHAR, typename DEST_STRING>
-bool ConvertUnicode(const SRC_CHAR* src,
-                    size_t src_len,
-                    DEST_STRING* output) {
-  bool success = true;
-  int32_t src_len32 = static_cast<int32_t>(src_len);
-  for (int32_t i = 0; i < src_len32; i++) {
-    uint32_t code_point;
-    if (base::ReadUnicodeCharacter(src, src_len32, &i, &code_point)) {
-      base::WriteUnicodeCharacter(code_point, output);
-    } else {
-      base::WriteUnicodeCharacter(0xFFFD, output);
-      success = false;
+// Returns the length of the ASCII prefix of |src|, widening it into |dest|, one
+// UTF-16 code unit per byte, if kWrite. Whole vectors are checked for a
+// non-ASCII byte at once, so long ASCII runs never reach the per-character
+// decoder.
+template <bool kWrite>
+size_t WidenASCIIPrefix(const char* src, size_t src_len, char16_t* dest) {
+  size_t i = 0;
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__AVX2__)
+  for (; src_len - i >= 32; i += 32) {
+    const __m256i bytes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    if (_mm256_movemask_epi8(bytes) != 0) {
+      break;
+    }
+    if constexpr (kWrite) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                          _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(dest + i + 16),
+          _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+    }
+  }
+#endif
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  for (; src_len - i >= 16; i += 16) {
+    const __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(bytes) != 0) {
+      break;
+    }
+    if constexpr (kWrite) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                       _mm_unpacklo_epi8(bytes, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i + 8),
+                       _mm_unpackhi_epi8(bytes, zero));
+    }
+  }
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+  for (; src_len - i >= 16; i += 16) {
+    const uint8x16_t bytes =
+        vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    if (vmaxvq_u8(bytes) >= 0x80) {
+      break;
+    }
+    if constexpr (kWrite) {
+      vst1q_u16(reinterpret_cast<uint16_t*>(dest + i),
+                vmovl_u8(vget_low_u8(bytes)));
+      vst1q_u16(reinterpret_cast<uint16_t*>(dest + i + 8),
+                vmovl_high_u8(bytes));
+    }
+  }
+#else
+  for (; src_len - i >= 8; i += 8) {
+    uint64_t word;
+    memcpy(&word, src + i, sizeof(word));
+    if ((word & 0x8080808080808080u) != 0) {
+      break;
+    }
+    if constexpr (kWrite) {
+      for (size_t j = 0; j < 8; ++j) {
+        dest[i + j] = static_cast<char16_t>(src[i + j]);
+      }
+    }
+  }
+#endif
+  for (; i < src_len && static_cast<unsigned char>(src[i]) < 0x80; ++i) {
+    if constexpr (kWrite) {
+      dest[i] = static_cast<char16_t>(src[i]);
+    }
+  }
+  return i;
+}
+
+// Decodes the non-ASCII UTF-8 sequence at the start of |src| and stores its
+// length in |*length|. An invalid sequence decodes as U+FFFD and clears
+// |*valid|. Well-formed two- and three-byte sequences, which cover most
+// scripts, are decoded inline; anything else goes through the validating ICU
+// decoder.
+inline uint32_t DecodeUTF8Sequence(const uint8_t* src,
+                                   size_t src_len,
+                                   size_t* length,
+                                   bool* valid) {
+  if (src_len >= 2 && src[0] >= 0xC2 && src[0] <= 0xDF &&
+      CBU8_IS_TRAIL(src[1])) {
+    *length = 2;
+    return ((src[0] & 0x1Fu) << 6) | (src[1] & 0x3Fu);
+  }
+  if (src_len >= 3 && (src[0] & 0xF0) == 0xE0 && CBU8_IS_TRAIL(src[1]) &&
+      CBU8_IS_TRAIL(src[2])) {
+    const uint32_t code_point = ((src[0] & 0x0Fu) << 12) |
+                                ((src[1] & 0x3Fu) << 6) | (src[2] & 0x3Fu);
+    // Reject overlong forms and surrogates.
+    if (code_point >= 0x800 && (code_point < 0xD800 || code_point > 0xDFFF)) {
+      *length = 3;
+      return code_point;
     }
   }
 
-  return success;
+  int32_t i = 0;
+  base_icu::UChar32 code_point;
+  CBU8_NEXT(src, i,
+            static_cast<int32_t>(std::min<size_t>(src_len, CBU8_MAX_LENGTH)),
+            code_point);
+  *length = static_cast<size_t>(i);
+  if (!base::IsValidCodepoint(static_cast<uint32_t>(code_point))) {
+    *valid = false;
+    return 0xFFFD;
+  }
+  return static_cast<uint32_t>(code_point);
+}
+
+// Converts |src| into |dest|, which has room for |dest_len| code units, and
+// returns the number of code units written, or, unless kWrite, that would have
+// been written. Stops before the first code point that does not fit, and
+// stores the number of bytes converted in |*consumed|. Each UTF-8 sequence,
+// valid or not, produces at most as many UTF-16 code units as it has bytes.
+template <bool kWrite>
+size_t ConvertUTF8ToUTF16(const char* src,
+                          size_t src_len,
+                          char16_t* dest,
+                          size_t dest_len,
+                          size_t* consumed,
+                          bool* valid) {
+  *valid = true;
+  size_t in = 0;
+  size_t out = 0;
+  while (in < src_len) {
+    const size_t ascii_length = WidenASCIIPrefix<kWrite>(
+        src + in, std::min(src_len - in, dest_len - out),
+        kWrite ? dest + out : nullptr);
+    in += ascii_length;
+    out += ascii_length;
+    if (out == dest_len) {
+      break;
+    }
+
+    // Decode code points one at a time until the next ASCII byte.
+    while (in < src_len && static_cast<unsigned char>(src[in]) >= 0x80) {
+      size_t length;
+      bool code_point_valid = true;
+      const uint32_t code_point =
+          DecodeUTF8Sequence(reinterpret_cast<const uint8_t*>(src + in),
+                             src_len - in, &length, &code_point_valid);
+      const size_t units = code_point <= 0xFFFF ? 1 : 2;
+      if (dest_len - out < units) {
+        *consumed = in;
+        return out;
+      }
+      in += length;
+      *valid &= code_point_valid;
+      if constexpr (kWrite) {
+        if (units == 1) {
+          dest[out] = static_cast<char16_t>(code_point);
+        } else {
+          dest[out] = static_cast<char16_t>((code_point >> 10) + 0xD7C0);
+          dest[out + 1] = static_cast<char16_t>((code_point & 0x3FF) | 0xDC00);
+        }
+      }
+      out += units;
+    }
+  }
+  *consumed = in;
+  return out;
+}
+
+// Returns the length of the suffix of |src| that is an incomplete sequence, one
+// that is well-formed so far and that more input could complete, or 0.
+size_t IncompleteUTF8SuffixLength(const uint8_t* src, size_t src_len) {
+  for (size_t k = 1; k <= std::min<size_t>(src_len, CBU8_MAX_LENGTH - 1); ++k) {
+    const uint8_t byte = src[src_len - k];
+    if (CBU8_IS_TRAIL(byte)) {
+      continue;
+    }
+    if (!CBU8_IS_LEAD(byte)) {
+      return 0;
+    }
+    const size_t needed = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : 2;
+    if (needed <= k) {
+      return 0;
+    }
+    // Only the first trail byte is restricted beyond being a trail byte.
+    if (k >= 2) {
+      const uint8_t t1 = src[src_len - k + 1];
+      if (needed == 3 ? !CBU8_IS_VALID_LEAD3_AND_T1(byte, t1)
+                      : !CBU8_IS_VALID_LEAD4_AND_T1(byte, t1)) {
+        return 0;
+      }
+    }
+    return k;
+  }
+  return 0;
+}
+
+// Appends the conversion of |src| to |*output|.
+bool AppendUTF8AsUTF16(const char* src,
+                       size_t src_len,
+                       std::u16string* output) {
+  const size_t old_size = output->size();
+  base::internal::Resize(*output, old_size + src_len,
+                         base::internal::priority_tag<1>());
+  size_t consumed;
+  bool valid;
+  output->resize(old_size +
+                 ConvertUTF8ToUTF16<true>(src, src_len,
+                                          output->data() + old_size, src_len,
+                                          &consumed, &valid));
+  return valid;
+}
+
+// UTF-16 is measured and converted in blocks of this many code units. A block
+// with no surrogates is handled with vector instructions where available.
+constexpr size_t kUTF16BlockSize = 8;
+
+// Reads the code point that starts at |src[*i]| and advances |*i| past it. A
+// lone surrogate reads as U+FFFD and clears |*valid|.
+inline uint32_t ReadUTF16CodePoint(const char16_t* src,
+                                   size_t src_len,
+                                   size_t* i,
+                                   bool* valid) {
+  const uint32_t code_unit = src[(*i)++];
+  if (!CBU16_IS_SURROGATE(code_unit)) {
+    return code_unit;
+  }
+  if (CBU16_IS_SURROGATE_LEAD(code_unit) && *i < src_len &&
+      CBU16_IS_TRAIL(src[*i])) {
+    return static_cast<uint32_t>(
+        CBU16_GET_SUPPLEMENTARY(code_unit, src[(*i)++]));
+  }
+  *valid = false;
+  return 0xFFFD;
+}
+
+// Returns the exact length in bytes of the UTF-8 that ConvertUTF16ToUTF8()
+// produces for |src|.
+size_t MeasureUTF16AsUTF8(const char16_t* src, size_t src_len) {
+  size_t length = 0;
+  size_t i = 0;
+  while (i < src_len) {
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+    // Each code unit takes three bytes, less one below U+0800 and one more
+    // below U+0080. The comparisons yield -1 per code unit below each bound,
+    // and are summed per lane, for few enough blocks that no lane overflows.
+    const __m128i zero = _mm_setzero_si128();
+    __m128i below = zero;
+    size_t blocks = 0;
+    for (; src_len - i >= kUTF16BlockSize && blocks < 16384;
+         i += kUTF16BlockSize, ++blocks) {
+      const __m128i units =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      const __m128i top_bits =
+          _mm_and_si128(units, _mm_set1_epi16(static_cast<int16_t>(0xF800)));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(
+              top_bits, _mm_set1_epi16(static_cast<int16_t>(0xD800)))) != 0) {
+        break;
+      }
+      below = _mm_add_epi16(
+          below,
+          _mm_add_epi16(
+              _mm_cmpeq_epi16(
+                  _mm_and_si128(units,
+                                _mm_set1_epi16(static_cast<int16_t>(0xFF80))),
+                  zero),
+              _mm_cmpeq_epi16(top_bits, zero)));
+    }
+    __m128i sums = _mm_madd_epi16(below, _mm_set1_epi16(-1));
+    sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, 0x4E));
+    sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, 0xB1));
+    length += 3 * kUTF16BlockSize * blocks -
+              static_cast<size_t>(_mm_cvtsi128_si32(sums));
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+    for (; src_len - i >= kUTF16BlockSize; i += kUTF16BlockSize) {
+      const uint16x8_t units =
+          vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+      if (vmaxvq_u16(vceqq_u16(vandq_u16(units, vdupq_n_u16(0xF800)),
+                               vdupq_n_u16(0xD800))) != 0) {
+        break;
+      }
+      // Each code unit takes one byte, plus one at or above U+0080 and one
+      // more at or above U+0800.
+      length += kUTF16BlockSize +
+                vaddvq_u16(vaddq_u16(
+                    vshrq_n_u16(vcgeq_u16(units, vdupq_n_u16(0x80)), 15),
+                    vshrq_n_u16(vcgeq_u16(units, vdupq_n_u16(0x800)), 15)));
+    }
+#endif
+    const size_t block_end = std::min(i + kUTF16BlockSize, src_len);
+    while (i < block_end) {
+      bool valid;
+      const uint32_t code_point = ReadUTF16CodePoint(src, src_len, &i, &valid);
+      length += CBU8_LENGTH(code_point);
+    }
+  }
+  return length;
+}
+
+// Converts |src| into |dest|, which has room for |dest_len| bytes, and returns
+// the number of bytes written. Stops before the first code point that does not
+// fit, and stores the number of code units converted in |*consumed|.
+size_t ConvertUTF16ToUTF8(const char16_t* src,
+                          size_t src_len,
+                          char* dest,
+                          size_t dest_len,
+                          size_t* consumed,
+                          bool* valid) {
+  bool all_valid = true;
+  size_t i = 0;
+  size_t out = 0;
+  while (i < src_len) {
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+    // ASCII blocks convert to as many bytes as they have code units.
+    const size_t ascii_end = i + std::min(src_len - i, dest_len - out);
+    for (; ascii_end - i >= kUTF16BlockSize; i += kUTF16BlockSize) {
+      const __m128i units =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(
+              _mm_and_si128(units,
+                            _mm_set1_epi16(static_cast<int16_t>(0xFF80))),
+              _mm_setzero_si128())) != 0xFFFF) {
+        break;
+      }
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + out),
+                       _mm_packus_epi16(units, units));
+      out += kUTF16BlockSize;
+    }
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_NEON)
+    const size_t ascii_end = i + std::min(src_len - i, dest_len - out);
+    for (; ascii_end - i >= kUTF16BlockSize; i += kUTF16BlockSize) {
+      const uint16x8_t units =
+          vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+      if (vmaxvq_u16(units) >= 0x80) {
+        break;
+      }
+      vst1_u8(reinterpret_cast<uint8_t*>(dest + out), vmovn_u16(units));
+      out += kUTF16BlockSize;
+    }
+#endif
+    const size_t block_end = std::min(i + kUTF16BlockSize, src_len);
+    while (i < block_end) {
+      size_t next = i;
+      bool code_point_valid = true;
+      const uint32_t code_point =
+          ReadUTF16CodePoint(src, src_len, &next, &code_point_valid);
+      if (dest_len - out < static_cast<size_t>(CBU8_LENGTH(code_point))) {
+        *consumed = i;
+        *valid = all_valid;
+        return out;
+      }
+      i = next;
+      all_valid &= code_point_valid;
+      CBU8_APPEND_UNSAFE(dest, out, code_point);
+    }
+  }
+  *consumed = i;
+  *valid = all_valid;
+  return out;
+}
+
+// Appends the conversion of |src| to |*output|.
+bool AppendUTF16AsUTF8(const char16_t* src,
+                       size_t src_len,
+                       std::string* output) {
+  const size_t old_size = output->size();
+  const size_t length = MeasureUTF16AsUTF8(src, src_len);
+  base::internal::Resize(*output, old_size + length,
+                         base::internal::priority_tag<1>());
+  size_t consumed;
+  bool valid;
+  ConvertUTF16ToUTF8(src, src_len, output->data() + old_size, length,
+                     &consumed, &valid);
+  return valid;
 }
 
 }  // namespace
@@ -38,8 +407,10 @@ bool ConvertUnicode(const SRC_CHAR* src,
 namespace base {
 
 bool UTF8ToUTF16(const char* src, size_t src_len, std::u16string* output) {
-  base::PrepareForUTF16Or32Output(src, src_len, output);
-  return ConvertUnicode(src, src_len, output);
+  // The output is sized for the worst case without initializing it, and
+  // trimmed afterwards.
+  output->clear();
+  return AppendUTF8AsUTF16(src, src_len, output);
 }
 
 std::u16string UTF8ToUTF16(std::string_view utf8) {
@@ -49,8 +420,10 @@ std::u16string UTF8ToUTF16(std::string_view utf8) {
 }
 
 bool UTF16ToUTF8(const char16_t* src, size_t src_len, std::string* output) {
-  base::PrepareForUTF8Output(src, src_len, output);
-  return ConvertUnicode(src, src_len, output);
+  // The input is measured first, so that the output is allocated once at its
+  // final size and never initialized twice.
+  output->clear();
+  return AppendUTF16AsUTF8(src, src_len, output);
 }
 
 std::string UTF16ToUTF8(std::u16string_view utf16) {
@@ -59,6 +432,121 @@ std::string UTF16ToUTF8(std::u16string_view utf16) {
   return ret;
 }
 
+UTFConversionResult UTF8ToUTF16(std::string_view utf8,
+                                span<char16_t> output) {
+  UTFConversionResult result;
+  result.produced = ConvertUTF8ToUTF16<true>(utf8.data(), utf8.size(),
+                                             output.data(), output.size(),
+                                             &result.consumed, &result.valid);
+  result.status = result.consumed == utf8.size()
+                      ? UTFConversionResult::Status::kDone
+                      : UTFConversionResult::Status::kNeedsMoreSpace;
+  return result;
+}
+
+UTFConversionResult UTF16ToUTF8(std::u16string_view utf16, span<char> output) {
+  UTFConversionResult result;
+  result.produced =
+      ConvertUTF16ToUTF8(utf16.data(), utf16.size(), output.data(),
+                         output.size(), &result.consumed, &result.valid);
+  result.status = result.consumed == utf16.size()
+                      ? UTFConversionResult::Status::kDone
+                      : UTFConversionResult::Status::kNeedsMoreSpace;
+  return result;
+}
+
+size_t UTF16LengthForUTF8(std::string_view utf8) {
+  size_t consumed;
+  bool valid;
+  return ConvertUTF8ToUTF16<false>(utf8.data(), utf8.size(), nullptr,
+                                   std::numeric_limits<size_t>::max(),
+                                   &consumed, &valid);
+}
+
+size_t UTF8LengthForUTF16(std::u16string_view utf16) {
+  return MeasureUTF16AsUTF8(utf16.data(), utf16.size());
+}
+
+void StreamingUTF8ToUTF16Converter::Feed(std::string_view input,
+                                         std::u16string* output) {
+  if (pending_length_ > 0) {
+    // Finish the held-back sequence with the start of |input|.
+    uint8_t sequence[CBU8_MAX_LENGTH];
+    memcpy(sequence, pending_, pending_length_);
+    const size_t taken =
+        std::min<size_t>(input.size(), CBU8_MAX_LENGTH - pending_length_);
+    memcpy(sequence + pending_length_, input.data(), taken);
+    const size_t sequence_length = pending_length_ + taken;
+    if (taken == input.size() &&
+        IncompleteUTF8SuffixLength(sequence, sequence_length) ==
+            sequence_length) {
+      memcpy(pending_, sequence, sequence_length);
+      pending_length_ = sequence_length;
+      return;
+    }
+
+    // The held-back bytes are a well-formed prefix, so decoding consumes all
+    // of them, valid or not.
+    size_t length;
+    WriteUnicodeCharacter(
+        DecodeUTF8Sequence(sequence, sequence_length, &length, &valid_),
+        output);
+    input.remove_prefix(length - pending_length_);
+    pending_length_ = 0;
+  }
+
+  pending_length_ = IncompleteUTF8SuffixLength(
+      reinterpret_cast<const uint8_t*>(input.data()), input.size());
+  memcpy(pending_, input.data() + input.size() - pending_length_,
+         pending_length_);
+  input.remove_suffix(pending_length_);
+  valid_ &= AppendUTF8AsUTF16(input.data(), input.size(), output);
+}
+
+bool StreamingUTF8ToUTF16Converter::Finish(std::u16string* output) {
+  if (pending_length_ > 0) {
+    WriteUnicodeCharacter(0xFFFD, output);
+    valid_ = false;
+  }
+  const bool valid = valid_;
+  pending_length_ = 0;
+  valid_ = true;
+  return valid;
+}
+
+void StreamingUTF16ToUTF8Converter::Feed(std::u16string_view input,
+                                         std::string* output) {
+  if (pending_lead_ != 0 && !input.empty()) {
+    if (CBU16_IS_TRAIL(input[0])) {
+      WriteUnicodeCharacter(static_cast<uint32_t>(CBU16_GET_SUPPLEMENTARY(
+                                pending_lead_, input[0])),
+                            output);
+      input.remove_prefix(1);
+    } else {
+      WriteUnicodeCharacter(0xFFFD, output);
+      valid_ = false;
+    }
+    pending_lead_ = 0;
+  }
+
+  if (!input.empty() && CBU16_IS_LEAD(input.back())) {
+    pending_lead_ = input.back();
+    input.remove_suffix(1);
+  }
+  valid_ &= AppendUTF16AsUTF8(input.data(), input.size(), output);
+}
+
+bool StreamingUTF16ToUTF8Converter::Finish(std::string* output) {
+  if (pending_lead_ != 0) {
+    WriteUnicodeCharacter(0xFFFD, output);
+    valid_ = false;
+  }
+  const bool valid = valid_;
+  pending_lead_ = 0;
+  valid_ = true;
+  return valid;
+}
+
 #if defined(WCHAR_T_IS_16_BIT)
 std::string WideToUTF8(std::wstring_view wide) {
   std::string ret;
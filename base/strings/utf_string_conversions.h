@@ -5,9 +5,13 @@
 #ifndef MINI_CHROMIUM_BASE_STRINGS_UTF_STRING_CONVERSIONS_H_
 #define MINI_CHROMIUM_BASE_STRINGS_UTF_STRING_CONVERSIONS_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <string>
 #include <string_view>
 
+#include "base/containers/span.h"
 #include "build/build_config.h"
 
 namespace base {
@@ -17,6 +21,86 @@ std::u16string UTF8ToUTF16(std::string_view utf8);
 bool UTF16ToUTF8(const char16_t* src, size_t src_len, std::string* output);
 std::string UTF16ToUTF8(std::u16string_view utf16);
 
+// The outcome of a conversion into a caller-provided buffer.
+struct UTFConversionResult {
+  enum class Status {
+    // All of the input was converted.
+    kDone,
+    // The output buffer filled up before all of the input was converted. The
+    // input from |consumed| on can be converted by another call.
+    kNeedsMoreSpace,
+  };
+
+  Status status;
+
+  // The number of input code units converted. This is always at a code point
+  // boundary.
+  size_t consumed;
+
+  // The number of code units written to the output buffer.
+  size_t produced;
+
+  // False if the converted input contained invalid sequences or lone
+  // surrogates, which were replaced by U+FFFD.
+  bool valid;
+};
+
+// These convert as much of the input as fits into |output| without allocating,
+// never writing a partial code point. The result is the same as that of the
+// string-returning versions, whether it is produced by one call or by several
+// calls that each resume from |consumed|.
+UTFConversionResult UTF8ToUTF16(std::string_view utf8, span<char16_t> output);
+UTFConversionResult UTF16ToUTF8(std::u16string_view utf16, span<char> output);
+
+// These return the exact number of code units that converting the input
+// produces, so that an output buffer can be sized before converting into it.
+size_t UTF16LengthForUTF8(std::string_view utf8);
+size_t UTF8LengthForUTF16(std::u16string_view utf16);
+
+// Converts a stream of UTF-8 delivered in chunks, such as reads from a file or
+// a pipe, to UTF-16. A sequence split across chunks is held back until the rest
+// of it arrives, so the output is the same as that of UTF8ToUTF16() on the
+// whole stream at once, while only one chunk needs to be in memory.
+class StreamingUTF8ToUTF16Converter {
+ public:
+  StreamingUTF8ToUTF16Converter() = default;
+
+  // Appends the conversion of |input| to |*output|, except for an incomplete
+  // sequence at its end.
+  void Feed(std::string_view input, std::u16string* output);
+
+  // Ends the stream, appending U+FFFD to |*output| if it ended within a
+  // sequence. Returns false if the stream contained invalid sequences. The
+  // converter can then be used for a new stream.
+  bool Finish(std::u16string* output);
+
+ private:
+  uint8_t pending_[3];
+  size_t pending_length_ = 0;
+  bool valid_ = true;
+};
+
+// Converts a stream of UTF-16 delivered in chunks to UTF-8, holding back a lead
+// surrogate at the end of a chunk until the next one. The output is the same
+// as that of UTF16ToUTF8() on the whole stream at once.
+class StreamingUTF16ToUTF8Converter {
+ public:
+  StreamingUTF16ToUTF8Converter() = default;
+
+  // Appends the conversion of |input| to |*output|, except for a lead surrogate
+  // at its end.
+  void Feed(std::u16string_view input, std::string* output);
+
+  // Ends the stream, appending U+FFFD to |*output| if it ended with a lead
+  // surrogate. Returns false if the stream contained lone surrogates. The
+  // converter can then be used for a new stream.
+  bool Finish(std::string* output);
+
+ private:
+  char16_t pending_lead_ = 0;
+  bool valid_ = true;
+};
+
 #if defined(WCHAR_T_IS_16_BIT)
 std::string WideToUTF8(std::wstring_view wide);
 std::wstring UTF8ToWide(std::string_view utf8);
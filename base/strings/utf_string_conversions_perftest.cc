@@ -0,0 +1,113 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/utf_string_conversions.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+
+#include "base/strings/utf_string_conversion_utils.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace {
+
+// About a megabyte of each kind of text.
+constexpr size_t kTextBytes = 1024 * 1024;
+
+struct Text {
+  const char* story;
+  std::string_view repeated;
+};
+
+constexpr Text kTexts[] = {
+    {"ascii", "The quick brown fox jumps over the lazy dog. "},
+    {"latin", "Größenwahn über Café crème à la française. "},
+    {"cjk", "日本語のテキストと中文文本。"},
+    {"emoji", "😀🎉👍🏽🚀 "},
+};
+
+std::string MakeText(std::string_view repeated) {
+  std::string text;
+  while (text.size() < kTextBytes) {
+    text.append(repeated);
+  }
+  return text;
+}
+
+// The character-at-a-time conversion that UTF8ToUTF16() and UTF16ToUTF8()
+// used before their fast paths, to compare against.
+template <typename SourceChar, typename DestinationString>
+void ConvertOneCharacterAtATime(const SourceChar* src,
+                                size_t src_len,
+                                DestinationString* output) {
+  const int32_t src_len32 = static_cast<int32_t>(src_len);
+  for (int32_t i = 0; i < src_len32; ++i) {
+    uint32_t code_point;
+    if (ReadUnicodeCharacter(src, src_len32, &i, &code_point)) {
+      WriteUnicodeCharacter(code_point, output);
+    } else {
+      WriteUnicodeCharacter(0xFFFD, output);
+    }
+  }
+}
+
+std::u16string ReferenceUTF8ToUTF16(std::string_view utf8) {
+  std::u16string utf16;
+  PrepareForUTF16Or32Output(utf8.data(), utf8.size(), &utf16);
+  ConvertOneCharacterAtATime(utf8.data(), utf8.size(), &utf16);
+  return utf16;
+}
+
+std::string ReferenceUTF16ToUTF8(std::u16string_view utf16) {
+  std::string utf8;
+  PrepareForUTF8Output(utf16.data(), utf16.size(), &utf8);
+  ConvertOneCharacterAtATime(utf16.data(), utf16.size(), &utf8);
+  return utf8;
+}
+
+// Reports the rate at which |convert| consumes |input_bytes|.
+template <typename Convert>
+void ReportGigabytesPerSecond(const char* metric,
+                              const char* story,
+                              size_t input_bytes,
+                              Convert convert) {
+  const double ns = perf_test::MeasureNanosecondsPerCall(convert);
+  perf_test::PrintResult(
+      metric, story, static_cast<double>(input_bytes) / ns, "GB_per_s");
+}
+
+}  // namespace
+
+PERF_TEST(UTFConversions, UTF8ToUTF16) {
+  for (const Text& text : kTexts) {
+    const std::string utf8 = MakeText(text.repeated);
+    ReportGigabytesPerSecond("utf8_to_utf16", text.story, utf8.size(), [&] {
+      perf_test::DoNotOptimize(UTF8ToUTF16(utf8));
+    });
+    ReportGigabytesPerSecond(
+        "utf8_to_utf16_reference", text.story, utf8.size(), [&] {
+          perf_test::DoNotOptimize(ReferenceUTF8ToUTF16(utf8));
+        });
+  }
+}
+
+PERF_TEST(UTFConversions, UTF16ToUTF8) {
+  for (const Text& text : kTexts) {
+    const std::u16string utf16 = UTF8ToUTF16(MakeText(text.repeated));
+    const size_t input_bytes = utf16.size() * sizeof(char16_t);
+    ReportGigabytesPerSecond("utf16_to_utf8", text.story, input_bytes, [&] {
+      perf_test::DoNotOptimize(UTF16ToUTF8(utf16));
+    });
+    ReportGigabytesPerSecond(
+        "utf16_to_utf8_reference", text.story, input_bytes, [&] {
+          perf_test::DoNotOptimize(ReferenceUTF16ToUTF8(utf16));
+        });
+  }
+}
+
+}  // namespace base
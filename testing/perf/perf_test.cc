@@ -0,0 +1,187 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "testing/perf/perf_test.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <algorithm>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "base/immediate_crash.h"
+#include "base/strings/pattern.h"
+
+namespace perf_test {
+
+namespace {
+
+struct PerfTest {
+  std::string name;
+  PerfTestFunction function;
+};
+
+struct Result {
+  std::string test;
+  std::string metric;
+  std::string story;
+  double value;
+  std::string units;
+};
+
+// Tests register themselves during static initialization, in no particular
+// order, so the list is created on first use.
+std::vector<PerfTest>& PerfTests() {
+  static std::vector<PerfTest>* const tests = new std::vector<PerfTest>();
+  return *tests;
+}
+
+std::vector<Result> g_results;
+const std::string* g_current_test = nullptr;
+
+constinit thread_local uint64_t g_thread_allocation_count = 0;
+
+void AppendJSONString(std::string_view string, std::string* out) {
+  out->push_back('"');
+  for (const char c : string) {
+    if (c == '"' || c == '\\') {
+      out->push_back('\\');
+      out->push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escape[7];
+      snprintf(escape, sizeof(escape), "\\u%04x", c);
+      out->append(escape);
+    } else {
+      out->push_back(c);
+    }
+  }
+  out->push_back('"');
+}
+
+}  // namespace
+
+bool RegisterPerfTest(const char* suite,
+                      const char* name,
+                      PerfTestFunction function) {
+  PerfTests().push_back({std::string(suite) + "." + name, function});
+  return true;
+}
+
+size_t RunPerfTests(std::string_view filter) {
+  std::vector<PerfTest>& tests = PerfTests();
+  std::sort(tests.begin(), tests.end(), [](const auto& a, const auto& b) {
+    return a.name < b.name;
+  });
+
+  size_t run = 0;
+  for (const PerfTest& test : tests) {
+    if (!base::MatchPattern(test.name, filter)) {
+      continue;
+    }
+    printf("[ RUN      ] %s\n", test.name.c_str());
+    fflush(stdout);
+    const int64_t start = NowNanoseconds();
+    g_current_test = &test.name;
+    test.function();
+    g_current_test = nullptr;
+    printf("[       OK ] %s (%" PRId64 " ms)\n",
+           test.name.c_str(),
+           (NowNanoseconds() - start) / 1000000);
+    fflush(stdout);
+    ++run;
+  }
+  return run;
+}
+
+void ListPerfTests() {
+  std::vector<PerfTest>& tests = PerfTests();
+  std::sort(tests.begin(), tests.end(), [](const auto& a, const auto& b) {
+    return a.name < b.name;
+  });
+  for (const PerfTest& test : tests) {
+    printf("%s\n", test.name.c_str());
+  }
+}
+
+bool WriteResultsAsJSON(const char* path) {
+  std::string json("[\n");
+  for (const Result& result : g_results) {
+    json += "  {\"test\": ";
+    AppendJSONString(result.test, &json);
+    json += ", \"metric\": ";
+    AppendJSONString(result.metric, &json);
+    json += ", \"story\": ";
+    AppendJSONString(result.story, &json);
+    char value[32];
+    snprintf(value, sizeof(value), "%.17g", result.value);
+    json += ", \"value\": ";
+    json += value;
+    json += ", \"units\": ";
+    AppendJSONString(result.units, &json);
+    json += &result == &g_results.back() ? "}\n" : "},\n";
+  }
+  json += "]\n";
+
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    return false;
+  }
+  const bool written = fwrite(json.data(), 1, json.size(), file) == json.size();
+  return fclose(file) == 0 && written;
+}
+
+void PrintResult(std::string_view metric,
+                 std::string_view story,
+                 double value,
+                 std::string_view units) {
+  printf("*RESULT %.*s: %.*s= %.17g %.*s\n",
+         static_cast<int>(metric.size()),
+         metric.data(),
+         static_cast<int>(story.size()),
+         story.data(),
+         value,
+         static_cast<int>(units.size()),
+         units.data());
+  fflush(stdout);
+  g_results.push_back({g_current_test ? *g_current_test : std::string(),
+                       std::string(metric),
+                       std::string(story),
+                       value,
+                       std::string(units)});
+}
+
+int64_t NowNanoseconds() {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return int64_t{now.tv_sec} * 1000000000 + now.tv_nsec;
+}
+
+uint64_t ThreadAllocationCount() {
+  return g_thread_allocation_count;
+}
+
+}  // namespace perf_test
+
+// The other forms of operator new and delete are implemented in terms of these,
+// except for the over-aligned ones, which are not counted.
+void* operator new(size_t size) {
+  ++perf_test::g_thread_allocation_count;
+  void* const memory = malloc(size ? size : 1);
+  if (!memory) {
+    base::ImmediateCrash();
+  }
+  return memory;
+}
+
+void operator delete(void* memory) noexcept {
+  free(memory);
+}
+
+void operator delete(void* memory, size_t size) noexcept {
+  free(memory);
+}
@@ -0,0 +1,100 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_TESTING_PERF_PERF_TEST_H_
+#define MINI_CHROMIUM_TESTING_PERF_PERF_TEST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string_view>
+
+// A minimal harness for benchmarks, which are defined with PERF_TEST() and run
+// by run_all_perftests.cc:
+//
+//   PERF_TEST(StringPrintf, Integer) {
+//     const double ns = perf_test::MeasureNanosecondsPerCall(
+//         [] { perf_test::DoNotOptimize(base::StringPrintf("%d", 42)); });
+//     perf_test::PrintResult("string_printf", "integer", ns, "ns");
+//   }
+//
+// Results are printed as they are reported, in the “*RESULT” format that
+// Chromium’s perf tooling parses, and with --json_output=<path> are also
+// written as JSON when all tests have run.
+#define PERF_TEST(suite, name)                                       \
+  static void suite##_##name##_PerfTest();                           \
+  [[maybe_unused]] static const bool suite##_##name##_registered =   \
+      ::perf_test::RegisterPerfTest(                                 \
+          #suite, #name, &suite##_##name##_PerfTest);                \
+  static void suite##_##name##_PerfTest()
+
+namespace perf_test {
+
+using PerfTestFunction = void (*)();
+
+// Adds |function| to the tests run as |suite|.|name|. Returns true so that it
+// can initialize a static variable.
+bool RegisterPerfTest(const char* suite,
+                      const char* name,
+                      PerfTestFunction function);
+
+// Runs the registered tests whose “suite.name” matches the glob |filter|, in
+// order of name, and returns the number run.
+size_t RunPerfTests(std::string_view filter);
+
+// Prints every registered test’s name.
+void ListPerfTests();
+
+// Writes the results reported so far to |path| as JSON. Returns false on
+// failure.
+bool WriteResultsAsJSON(const char* path);
+
+// Reports that |metric| measured |value| |units| for |story|, the variant of
+// the test that was run, such as the number of threads.
+void PrintResult(std::string_view metric,
+                 std::string_view story,
+                 double value,
+                 std::string_view units);
+
+// Returns the time from a monotonic clock.
+int64_t NowNanoseconds();
+
+// Keeps the compiler from discarding the computation of |value|.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Keeps the compiler from moving memory accesses across the call, or from
+// discarding stores before it.
+inline void ClobberMemory() {
+  asm volatile("" : : : "memory");
+}
+
+// Calls |body| in batches, doubling the batch until one takes at least 100 ms,
+// and returns the mean time per call during that batch. Each call is kept, even
+// if |body| has no effect.
+template <typename Body>
+double MeasureNanosecondsPerCall(Body body) {
+  constexpr int64_t kMinimumBatchNanoseconds = 100 * 1000 * 1000;
+  for (uint64_t calls = 1;; calls *= 2) {
+    const int64_t start = NowNanoseconds();
+    for (uint64_t call = 0; call < calls; ++call) {
+      body();
+      ClobberMemory();
+    }
+    const int64_t elapsed = NowNanoseconds() - start;
+    if (elapsed >= kMinimumBatchNanoseconds) {
+      return static_cast<double>(elapsed) / static_cast<double>(calls);
+    }
+  }
+}
+
+// Returns the number of times the calling thread has called operator new. The
+// harness replaces the global operator new to count them.
+uint64_t ThreadAllocationCount();
+
+}  // namespace perf_test
+
+#endif  // MINI_CHROMIUM_TESTING_PERF_PERF_TEST_H_
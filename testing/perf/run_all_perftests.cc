@@ -0,0 +1,54 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Runs the benchmarks defined with PERF_TEST().
+//
+// Usage: <perftests> [--filter=<glob>] [--json_output=<path>] [--list]
+//
+// --filter selects tests by “suite.name”, as MatchPattern() matches it.
+// --json_output writes every reported result to |path| as a JSON array of
+// objects with “test”, “metric”, “story”, “value” and “units” members, to be
+// compared between builds.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string_view>
+
+#include "testing/perf/perf_test.h"
+
+int main(int argc, char* argv[]) {
+  std::string_view filter("*");
+  const char* json_output = nullptr;
+  for (int index = 1; index < argc; ++index) {
+    const std::string_view arg(argv[index]);
+    if (arg.starts_with("--filter=")) {
+      filter = arg.substr(strlen("--filter="));
+    } else if (arg.starts_with("--json_output=")) {
+      json_output = argv[index] + strlen("--json_output=");
+    } else if (arg == "--list") {
+      perf_test::ListPerfTests();
+      return 0;
+    } else {
+      fprintf(stderr,
+              "usage: %s [--filter=<glob>] [--json_output=<path>] [--list]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+
+  if (perf_test::RunPerfTests(filter) == 0) {
+    fprintf(stderr, "%s: no tests match %.*s\n",
+            argv[0],
+            static_cast<int>(filter.size()),
+            filter.data());
+    return 1;
+  }
+
+  if (json_output && !perf_test::WriteResultsAsJSON(json_output)) {
+    perror(json_output);
+    return 1;
+  }
+  return 0;
+}
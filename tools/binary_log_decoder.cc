@@ -0,0 +1,427 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Decodes a binary log written by BLOG() into the text format of LOG().
+//
+// Usage: binary_log_decoder [binary_log_file]
+//
+// Reads standard input if no file is given. Records are written in the order
+// in which their threads wrote them out, which is only approximately the order
+// in which they were logged.
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "base/binary_log.h"
+
+namespace {
+
+using logging::internal::BinaryLogArgType;
+
+struct Site {
+  int32_t severity;
+  uint32_t line;
+  std::string file;
+  std::string format;
+  std::vector<BinaryLogArgType> arg_types;
+};
+
+// Sites by pid and site ID.
+using SiteMap = std::map<std::pair<uint32_t, uint32_t>, Site>;
+
+struct Arg {
+  BinaryLogArgType type;
+  union {
+    int64_t i;
+    uint64_t u;
+    double d;
+  };
+  std::string s;
+};
+
+// Reads values from a frame, failing once anything would be read past its end.
+class Reader {
+ public:
+  explicit Reader(std::string_view data) : data_(data) {}
+
+  template <typename T>
+  bool Read(T* value) {
+    if (data_.size() < sizeof(*value)) {
+      return false;
+    }
+    memcpy(value, data_.data(), sizeof(*value));
+    data_.remove_prefix(sizeof(*value));
+    return true;
+  }
+
+  bool ReadBytes(size_t size, std::string_view* bytes) {
+    if (data_.size() < size) {
+      return false;
+    }
+    *bytes = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return true;
+  }
+
+  bool ReadString(std::string* string) {
+    uint32_t length;
+    std::string_view bytes;
+    if (!Read(&length) || !ReadBytes(length, &bytes)) {
+      return false;
+    }
+    string->assign(bytes);
+    return true;
+  }
+
+  bool empty() const { return data_.empty(); }
+
+ private:
+  std::string_view data_;
+};
+
+template <typename... Args>
+void AppendF(std::string* out, const char* format, Args... args) {
+  char buffer[256];
+  const int length = snprintf(buffer, sizeof(buffer), format, args...);
+  if (length < 0) {
+    return;
+  }
+  if (static_cast<size_t>(length) < sizeof(buffer)) {
+    out->append(buffer, static_cast<size_t>(length));
+    return;
+  }
+  std::string large(static_cast<size_t>(length) + 1, '\0');
+  snprintf(large.data(), large.size(), format, args...);
+  large.pop_back();
+  out->append(large);
+}
+
+// Applies the printf-style |format| to |args|, as printf() would have when the
+// record was logged.
+std::string FormatMessage(const std::string& format,
+                          const std::vector<Arg>& args) {
+  std::string out;
+  size_t next_arg = 0;
+  auto take_int = [&]() -> int {
+    return next_arg < args.size() ? static_cast<int>(args[next_arg++].i) : 0;
+  };
+
+  for (size_t index = 0; index < format.size(); ++index) {
+    if (format[index] != '%') {
+      out.push_back(format[index]);
+      continue;
+    }
+    if (index + 1 < format.size() && format[index + 1] == '%') {
+      out.push_back('%');
+      ++index;
+      continue;
+    }
+
+    // Rebuild the conversion specification without its length modifier, and
+    // with any '*' width or precision replaced by its argument.
+    std::string spec("%");
+    ++index;
+    while (index < format.size() && strchr("-+ #0'", format[index])) {
+      spec.push_back(format[index++]);
+    }
+    for (int part = 0; part < 2; ++part) {
+      if (part == 1) {
+        if (index >= format.size() || format[index] != '.') {
+          break;
+        }
+        spec.push_back(format[index++]);
+      }
+      if (index < format.size() && format[index] == '*') {
+        spec += std::to_string(take_int());
+        ++index;
+      }
+      while (index < format.size() && format[index] >= '0' &&
+             format[index] <= '9') {
+        spec.push_back(format[index++]);
+      }
+    }
+    int integer_bits = 32;
+    while (index < format.size() && strchr("hljztLq", format[index])) {
+      integer_bits = format[index] == 'h' ? integer_bits / 2 : 64;
+      ++index;
+    }
+    if (index >= format.size()) {
+      break;
+    }
+    const char conversion = format[index];
+
+    if (conversion == 'n') {
+      continue;
+    }
+    if (next_arg >= args.size()) {
+      out += "<missing argument>";
+      continue;
+    }
+    const Arg& arg = args[next_arg++];
+
+    switch (conversion) {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+      case 'c': {
+        // Reproduce the conversion of the argument to the type named by the
+        // format’s length modifier.
+        uint64_t value = arg.u;
+        int64_t signed_value;
+        if (integer_bits < 64) {
+          const uint64_t mask = (uint64_t{1} << integer_bits) - 1;
+          const uint64_t sign = uint64_t{1} << (integer_bits - 1);
+          value &= mask;
+          signed_value = static_cast<int64_t>((value ^ sign) - sign);
+        } else {
+          signed_value = static_cast<int64_t>(value);
+        }
+        if (conversion == 'c') {
+          spec.push_back('c');
+          AppendF(&out, spec.c_str(), static_cast<int>(value));
+        } else if (conversion == 'd' || conversion == 'i') {
+          spec += "lld";
+          AppendF(&out, spec.c_str(), static_cast<long long>(signed_value));
+        } else {
+          spec += "ll";
+          spec.push_back(conversion);
+          AppendF(&out, spec.c_str(), static_cast<unsigned long long>(value));
+        }
+        break;
+      }
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+        spec.push_back(conversion);
+        AppendF(&out, spec.c_str(), arg.d);
+        break;
+      case 's':
+        spec.push_back('s');
+        AppendF(&out, spec.c_str(), arg.s.c_str());
+        break;
+      case 'p':
+        spec.push_back('p');
+        AppendF(&out, spec.c_str(),
+                reinterpret_cast<void*>(static_cast<uintptr_t>(arg.u)));
+        break;
+      default:
+        out.push_back('%');
+        out.push_back(conversion);
+        break;
+    }
+  }
+  return out;
+}
+
+void AppendHeader(std::string* out,
+                  uint32_t pid,
+                  uint64_t tid,
+                  uint64_t time_us,
+                  const Site& site) {
+  const time_t seconds = static_cast<time_t>(time_us / 1000000);
+  tm local_time;
+  localtime_r(&seconds, &local_time);
+  AppendF(out,
+          "[%" PRIu32 ":%" PRIu64 ":%04d%02d%02d,%02d%02d%02d.%06u:",
+          pid,
+          tid,
+          local_time.tm_year + 1900,
+          local_time.tm_mon + 1,
+          local_time.tm_mday,
+          local_time.tm_hour,
+          local_time.tm_min,
+          local_time.tm_sec,
+          static_cast<unsigned int>(time_us % 1000000));
+
+  static constexpr const char* kSeverityNames[] = {
+      "INFO", "WARNING", "ERROR", "ERROR_REPORT", "FATAL"};
+  if (site.severity < 0) {
+    AppendF(out, "VERBOSE%d", -site.severity);
+  } else if (static_cast<size_t>(site.severity) < std::size(kSeverityNames)) {
+    out->append(kSeverityNames[site.severity]);
+  } else {
+    AppendF(out, "%d", site.severity);
+  }
+
+  std::string_view file(site.file);
+  const size_t last_slash = file.find_last_of("\\/");
+  if (last_slash != std::string_view::npos) {
+    file.remove_prefix(last_slash + 1);
+  }
+  out->push_back(' ');
+  out->append(file);
+  AppendF(out, ":%" PRIu32 "] ", site.line);
+}
+
+bool DecodeSite(Reader* reader, SiteMap* sites) {
+  uint32_t pid;
+  uint32_t id;
+  Site site;
+  uint32_t arg_count;
+  if (!reader->Read(&pid) || !reader->Read(&id) ||
+      !reader->Read(&site.severity) ||
+      !reader->Read(&site.line) || !reader->ReadString(&site.file) ||
+      !reader->ReadString(&site.format) || !reader->Read(&arg_count)) {
+    return false;
+  }
+  for (uint32_t index = 0; index < arg_count; ++index) {
+    BinaryLogArgType type;
+    if (!reader->Read(&type)) {
+      return false;
+    }
+    site.arg_types.push_back(type);
+  }
+  (*sites)[{pid, id}] = std::move(site);
+  return true;
+}
+
+// Gives a child process the sites of its parent. Any left from an earlier
+// process with the same pid are discarded.
+bool DecodeFork(Reader* reader, SiteMap* sites) {
+  uint32_t pid;
+  uint32_t parent_pid;
+  if (!reader->Read(&pid) || !reader->Read(&parent_pid)) {
+    return false;
+  }
+  sites->erase(sites->lower_bound({pid, 0}), sites->upper_bound({pid, ~0u}));
+  if (pid == parent_pid) {
+    return true;
+  }
+  const auto parent_end = sites->upper_bound({parent_pid, ~0u});
+  for (auto site = sites->lower_bound({parent_pid, 0}); site != parent_end;
+       ++site) {
+    sites->emplace_hint(sites->end(),
+                        std::make_pair(pid, site->first.second),
+                        site->second);
+  }
+  return true;
+}
+
+bool DecodeRecords(Reader* reader,
+                   const SiteMap& sites,
+                   std::string* out) {
+  uint32_t pid;
+  uint64_t tid;
+  uint32_t length;
+  std::string_view records_data;
+  if (!reader->Read(&pid) || !reader->Read(&tid) || !reader->Read(&length) ||
+      !reader->ReadBytes(length, &records_data)) {
+    return false;
+  }
+
+  Reader records(records_data);
+  while (!records.empty()) {
+    uint32_t id;
+    uint64_t time_us;
+    if (!records.Read(&id) || !records.Read(&time_us)) {
+      return false;
+    }
+    const auto site = sites.find({pid, id});
+    if (site == sites.end()) {
+      fprintf(stderr,
+              "binary_log_decoder: undefined site %" PRIu32 " in pid %" PRIu32
+              "\n",
+              id,
+              pid);
+      return false;
+    }
+
+    std::vector<Arg> args(site->second.arg_types.size());
+    for (size_t index = 0; index < args.size(); ++index) {
+      Arg& arg = args[index];
+      arg.type = site->second.arg_types[index];
+      const bool ok = arg.type == BinaryLogArgType::kString
+                          ? records.ReadString(&arg.s)
+                          : records.Read(&arg.u);
+      if (!ok) {
+        return false;
+      }
+    }
+
+    AppendHeader(out, pid, tid, time_us, site->second);
+    out->append(FormatMessage(site->second.format, args));
+    out->push_back('\n');
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    fprintf(stderr, "usage: %s [binary_log_file]\n", argv[0]);
+    return 1;
+  }
+
+  FILE* file = argc == 2 ? fopen(argv[1], "rb") : stdin;
+  if (!file) {
+    perror(argv[1]);
+    return 1;
+  }
+  std::string data;
+  char buffer[64 * 1024];
+  size_t size;
+  while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.append(buffer, size);
+  }
+  if (file != stdin) {
+    fclose(file);
+  }
+
+  Reader reader(data);
+  std::string_view magic;
+  uint32_t byte_order_mark;
+  if (!reader.ReadBytes(sizeof(logging::internal::kBinaryLogMagic), &magic) ||
+      magic != std::string_view(logging::internal::kBinaryLogMagic,
+                                sizeof(logging::internal::kBinaryLogMagic)) ||
+      !reader.Read(&byte_order_mark)) {
+    fprintf(stderr, "binary_log_decoder: not a binary log\n");
+    return 1;
+  }
+  if (byte_order_mark != logging::internal::kBinaryLogByteOrderMark) {
+    fprintf(stderr, "binary_log_decoder: byte order mismatch\n");
+    return 1;
+  }
+
+  SiteMap sites;
+  std::string out;
+  while (!reader.empty()) {
+    uint8_t tag;
+    reader.Read(&tag);
+    bool ok;
+    if (tag == logging::internal::kBinaryLogSiteFrame) {
+      ok = DecodeSite(&reader, &sites);
+    } else if (tag == logging::internal::kBinaryLogRecordsFrame) {
+      ok = DecodeRecords(&reader, sites, &out);
+    } else if (tag == logging::internal::kBinaryLogForkFrame) {
+      ok = DecodeFork(&reader, &sites);
+    } else {
+      ok = false;
+    }
+    fwrite(out.data(), 1, out.size(), stdout);
+    out.clear();
+    if (!ok) {
+      fprintf(stderr, "binary_log_decoder: truncated or corrupt log\n");
+      return 1;
+    }
+  }
+  return 0;
+}